@@ -14,8 +14,15 @@
 #include <utility>
 #include <algorithm>
 #include <cstdlib>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <exception>
 #include <type_traits>
 #include <filesystem>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 //#define EIGEN_USE_DYNAMIC
 //#define USE_MACH_DATA
@@ -23,6 +30,11 @@
 
 #include "nlohmann/json.hpp"
 #include "interpolate.h"
+#include "airfoil_query_cache.h"
+#include "polar_json_reader.h"
+#include "polar_cache.h"
+#include "useful_datatypes/job_runner.h"
+#include "spline_polar.h"
 #include "unsupported/meta_checks.h"
 #include "unsupported/useful_expressions.h"
 #include "unsupported/debug_utils.h"
@@ -30,18 +42,19 @@
 
 struct airfoil_surrogate_model {
 #ifdef USE_MACH_DATA
-    std::shared_ptr<itp::interpolate<3, 500000, 5>> CL;
-    std::shared_ptr<itp::interpolate<3, 500000, 5>> CD;
-    std::shared_ptr<itp::interpolate<2, 5000, 5>> positive_stall;
-    std::shared_ptr<itp::interpolate<2, 5000, 5>> negative_stall;
-    std::shared_ptr<itp::interpolate<2, 5000, 5>> max_cl_cd_angle;
+    using polar_model = itp::interpolate<3, 500000, 5, itp::runtime_storage>;
+    using stall_model = itp::interpolate<2, 5000, 5, itp::runtime_storage>;
 #else
-    std::shared_ptr<itp::interpolate<2, 50000, 5>> CL;
-    std::shared_ptr<itp::interpolate<2, 50000, 5>> CD;
-    std::shared_ptr<itp::interpolate<1, 500, 5>> positive_stall;
-    std::shared_ptr<itp::interpolate<1, 500, 5>> negative_stall;
-    std::shared_ptr<itp::interpolate<1, 500, 5>> max_cl_cd_angle;
+    using polar_model = itp::interpolate<2, 50000, 5, itp::runtime_storage>;
+    using stall_model = itp::interpolate<1, 500, 5, itp::runtime_storage>;
 #endif
+    std::shared_ptr<polar_model> CL;
+    std::shared_ptr<polar_model> CD;
+    std::shared_ptr<stall_model> positive_stall;
+    std::shared_ptr<stall_model> negative_stall;
+    std::shared_ptr<stall_model> max_cl_cd_angle;
+    std::shared_ptr<itp::spline_polar> CL_spline;
+    std::shared_ptr<itp::spline_polar> CD_spline;
     std::vector<std::pair<float, float>> airfoil_coordinates_upper;
     std::vector<std::pair<float, float>> airfoil_coordinates_lower;
 
@@ -53,26 +66,53 @@ struct airfoil_surrogate_model {
     float max_thickness_ratio{};
     bool surrogate_built;
 
-#ifdef USE_MACH_DATA
-    airfoil_surrogate_model ()
-            : CL(std::make_shared<itp::interpolate<3, 500000, 5>>()),
-              CD(std::make_shared<itp::interpolate<3, 500000, 5>>()),
-              positive_stall(std::make_shared<itp::interpolate<2, 5000, 5>>()),
-              negative_stall(std::make_shared<itp::interpolate<2, 5000, 5>>()),
-              max_cl_cd_angle(std::make_shared<itp::interpolate<2, 5000, 5>>()),
-              surrogate_built(false){}
-#else
+    /** @brief The one build of the model and its failure, if any, shared by copies */
+    struct build_state {
+        std::once_flag once;
+        std::exception_ptr error;
+    };
+    std::shared_ptr<build_state> build;
+
     airfoil_surrogate_model ()
-            : CL(std::make_shared<itp::interpolate<2, 50000, 5>>()),
-              CD(std::make_shared<itp::interpolate<2, 50000, 5>>()),
-              positive_stall(std::make_shared<itp::interpolate<1, 500, 5>>()),
-              negative_stall(std::make_shared<itp::interpolate<1, 500, 5>>()),
-              max_cl_cd_angle(std::make_shared<itp::interpolate<1, 500, 5>>()),
-              surrogate_built(false){}
-#endif
+            : CL(std::make_shared<polar_model>()),
+              CD(std::make_shared<polar_model>()),
+              positive_stall(std::make_shared<stall_model>()),
+              negative_stall(std::make_shared<stall_model>()),
+              max_cl_cd_angle(std::make_shared<stall_model>()),
+              surrogate_built(false),
+              build(std::make_shared<build_state>()){}
 };
 
 namespace concpt {
+    /**
+     * @brief Interned handle of an airfoil of one airfoil_polar, see airfoil_polar::get_airfoil_id.
+     *
+     * @details Indexes the dense model table of the polar it was obtained from, so lookups by handle hash no strings.
+     * Handles stay valid for the lifetime of that polar; they are meaningless for any other one.
+     */
+    struct airfoil_id {
+        static constexpr std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t value = invalid;
+
+        airfoil_id () = default;
+        explicit airfoil_id (const std::uint32_t IN_VALUE) noexcept : value(IN_VALUE) {}
+
+        [[nodiscard]] bool valid () const noexcept {
+            return this->value != invalid;
+        }
+
+        friend bool operator== (const airfoil_id&, const airfoil_id&) = default;
+    };
+
+    /**
+     * @brief CL and CD with their analytic derivatives with respect to the angle of attack.
+     */
+    struct airfoil_aero_derivatives {
+        float CL{}, CD{};
+        float dCL_dalpha{}, dCD_dalpha{};
+    };
+
     class airfoil_polar {
     public:
         std::unordered_map<std::string, airfoil_surrogate_model> surrogate_hash_map;
@@ -80,6 +120,12 @@ namespace concpt {
         airfoil_polar () = default;
         virtual ~airfoil_polar () = default;
 
+        // the model table points into surrogate_hash_map, which a copy would not carry over; moves keep its nodes
+        airfoil_polar (const airfoil_polar&) = delete;
+        airfoil_polar& operator= (const airfoil_polar&) = delete;
+        airfoil_polar (airfoil_polar&&) = default;
+        airfoil_polar& operator= (airfoil_polar&&) = default;
+
         explicit airfoil_polar (const std::vector<std::string> &IN_AIRFOILS, const bool IN_TRAIN_IN_PLACE = false,
                                 const bool IN_BUILD_IN_PLACE = false) : airfoil_index(IN_AIRFOILS) {
             std::sort(this->airfoil_index.begin(), this->airfoil_index.end());
@@ -99,12 +145,91 @@ namespace concpt {
             this->number_of_airfoils = this->airfoil_index.size();
 
             this->build_hash_map();
-            this->build_training_data();
-            this->build_surrogate_models();
+            if (!this->lazy_build) {
+                this->build_training_data();
+                this->build_surrogate_models();
+            }
+            if (this->query_cache) this->query_cache->clear();
         }
 
+        /**
+         * @brief Surrogate model of @p IN_AIRFOIL_NAME, generated and built first in lazy mode.
+         *
+         * @throw std::out_of_range Thrown if the airfoil was not added.
+         */
         airfoil_surrogate_model& hash_airfoil (const std::string &IN_AIRFOIL_NAME) {
-            return this->surrogate_hash_map.at(IN_AIRFOIL_NAME);
+            return this->hash_airfoil(this->get_airfoil_id(IN_AIRFOIL_NAME));
+        }
+
+        /**
+         * @brief Surrogate model of the airfoil @p IN_AIRFOIL, generated and built first in lazy mode.
+         *
+         * @throw std::out_of_range Thrown if @p IN_AIRFOIL is not a handle of this polar.
+         */
+        airfoil_surrogate_model& hash_airfoil (const airfoil_id &IN_AIRFOIL) {
+            auto &[name, model] = *this->model_table.at(IN_AIRFOIL.value);
+            if (this->lazy_build) this->build_airfoil_once(name, model);
+            return model;
+        }
+
+        /**
+         * @brief Discards the surrogates of the airfoil @p IN_AIRFOIL and builds it again, generating its training
+         * data first in lazy mode. The only way to retry a failed build.
+         *
+         * @details The surrogates are replaced by empty ones before the build, so a retry never adds training data to
+         * what a failed build left behind. Must not run concurrently with queries of the same airfoil.
+         *
+         * @throw std::out_of_range Thrown if @p IN_AIRFOIL is not a handle of this polar.
+         * @throw Rethrows the failure of the build, which later accesses rethrow as well.
+         */
+        airfoil_surrogate_model& rebuild (const airfoil_id &IN_AIRFOIL) {
+            auto &[name, model] = *this->model_table.at(IN_AIRFOIL.value);
+            model = airfoil_surrogate_model();
+            if (this->query_cache) this->query_cache->clear();
+            this->build_airfoil_once(name, model);
+            return model;
+        }
+
+        /**
+         * @throw std::out_of_range Thrown if the airfoil was not added.
+         */
+        airfoil_surrogate_model& rebuild (const std::string &IN_AIRFOIL_NAME) {
+            return this->rebuild(this->get_airfoil_id(IN_AIRFOIL_NAME));
+        }
+
+        /**
+         * @brief Interns @p IN_AIRFOIL_NAME. Resolve handles once, e.g. when a blade is built, and query with them.
+         *
+         * @throw std::out_of_range Thrown if the airfoil was not added.
+         */
+        [[nodiscard]] airfoil_id get_airfoil_id (const std::string &IN_AIRFOIL_NAME) const {
+            const auto found = this->model_ids.find(IN_AIRFOIL_NAME);
+            if (found == this->model_ids.end()) throw std::out_of_range("Airfoil is not part of the polar -> " + IN_AIRFOIL_NAME);
+            return found->second;
+        }
+
+        /**
+         * @throw std::out_of_range Thrown if @p IN_AIRFOIL is not a handle of this polar.
+         */
+        [[nodiscard]] const std::string& get_airfoil_name (const airfoil_id &IN_AIRFOIL) const {
+            return this->model_table.at(IN_AIRFOIL.value)->first;
+        }
+
+        /**
+         * @brief Selects lazy mode, where airfoils are neither generated nor built when they are added, but on the
+         * first `hash_airfoil`, `get_aero_values` or `get_aero_derivatives` call naming them.
+         *
+         * @details Every airfoil is built once, also when several threads ask for it at the same time: the first one
+         * builds it and the others wait for it. A failed build is not retried: its failure is rethrown by every later
+         * access of the airfoil until `rebuild` succeeds. Airfoils built later
+         * pick up the current grid interpolation mode, but not lookup tables or spline surrogates created before them.
+         */
+        void set_lazy_build (const bool IN_LAZY) noexcept {
+            this->lazy_build = IN_LAZY;
+        }
+
+        [[nodiscard]] bool is_lazy_build () const noexcept {
+            return this->lazy_build;
         }
 
         [[nodiscard]] std::string get_airfoil_from_index (std::size_t INDEX) const {
@@ -115,75 +240,392 @@ namespace concpt {
             return this->airfoil_index;
         }
 
-        std::pair<float, float> get_aero_values (const std::string &IN_AIRFOIL, const float &IN_ALPHA, const float &IN_RE,
-                                                 const float &IN_MACH = 0.0f, const float &IN_MULTIPLIER = 1.0f) {
+        /**
+         * @brief Selects multilinear interpolation over the polar grid (default) or the k-nearest points average for CL and CD.
+         *
+         * @details Polars that are not a full rectilinear grid always use the k-nearest points average through a kd-tree
+         * index. Applies to the already built surrogates and to the ones built later.
+         *
+         * @param [in] IN_USE_GRID true to use the grid when the polar allows it.
+         */
+        void set_grid_interpolation (const bool IN_USE_GRID) {
+            this->use_grid_interpolation = IN_USE_GRID;
+            for (auto &[name, model] : this->surrogate_hash_map) {
+                if (model.surrogate_built) this->build_query_structures(model);
+            }
+            if (this->query_cache) this->query_cache->clear();
+        }
+
+        /**
+         * @brief Samples the CL and CD surrogates of every built airfoil onto dense lookup tables.
+         *
+         * @details Each surrogate is evaluated on a regular grid over its [min_alpha, max_alpha] x [min_Re, max_Re] box
+         * (and [min_mach, max_mach] with mach data), linear in alpha and mach and geometric in Re. Later queries are a
+         * multilinear lerp of the table. Airfoils whose polar already is a rectilinear grid keep interpolating it
+         * directly. `set_grid_interpolation` drops the tables again.
+         *
+         * @param [in] IN_ALPHA_RESOLUTION Number of alpha nodes.
+         * @param [in] IN_RE_RESOLUTION Number of Re nodes.
+         * @param [in] IN_MACH_RESOLUTION Number of mach nodes, only used with mach data.
+         *
+         * @return Estimated maximum deviation of the CL and CD tables from the k-nearest points surrogates, per baked
+         * airfoil, see `itp::interpolate::bake_grid`.
+         *
+         * @throw std::invalid_argument Thrown if a resolution is zero.
+         */
+        std::unordered_map<std::string, std::pair<float, float>> bake_lookup_tables (const std::size_t IN_ALPHA_RESOLUTION = 401,
+                                                                                     const std::size_t IN_RE_RESOLUTION = 101,
+                                                                                     const std::size_t IN_MACH_RESOLUTION = 11) {
+            if (IN_ALPHA_RESOLUTION == 0 || IN_RE_RESOLUTION == 0 || IN_MACH_RESOLUTION == 0) {
+                throw std::invalid_argument("Lookup table resolution needs to be positive");
+            }
+
+            auto linear_axis = [] (const float IN_MIN, const float IN_MAX, const std::size_t IN_RESOLUTION) -> std::vector<float> {
+                if (IN_RESOLUTION == 1 || !(IN_MAX > IN_MIN)) return {IN_MIN};
+                std::vector<float> OUT_AXIS(IN_RESOLUTION);
+                for (std::size_t i = 0; i < IN_RESOLUTION; i++) {
+                    OUT_AXIS[i] = IN_MIN + (IN_MAX - IN_MIN) * static_cast<float>(i) / static_cast<float>(IN_RESOLUTION - 1);
+                }
+                return OUT_AXIS;
+            };
+            auto geometric_axis = [] (const float IN_MIN, const float IN_MAX, const std::size_t IN_RESOLUTION) -> std::vector<float> {
+                if (IN_RESOLUTION == 1 || !(IN_MAX > IN_MIN) || !(IN_MIN > 0.0f)) return {IN_MIN};
+                std::vector<float> OUT_AXIS(IN_RESOLUTION);
+                for (std::size_t i = 0; i < IN_RESOLUTION; i++) {
+                    OUT_AXIS[i] = IN_MIN * std::pow(IN_MAX / IN_MIN, static_cast<float>(i) / static_cast<float>(IN_RESOLUTION - 1));
+                }
+                OUT_AXIS.back() = IN_MAX;
+                OUT_AXIS.erase(std::unique(OUT_AXIS.begin(), OUT_AXIS.end()), OUT_AXIS.end());
+                return OUT_AXIS;
+            };
+
+            std::unordered_map<std::string, std::pair<float, float>> OUT_DEVIATIONS;
+            for (auto &[name, model] : this->surrogate_hash_map) {
+                if (!model.surrogate_built) continue;
+                this->build_query_structures(model);
+                if (model.CL->has_grid()) continue;
 #ifdef USE_MACH_DATA
-            return std::make_pair(this->surrogate_hash_map.at(IN_AIRFOIL).CL->eval_at_with_weighted_sum(
-                    IN_ALPHA, IN_RE, IN_MACH) * IN_MULTIPLIER, this->surrogate_hash_map.at(IN_AIRFOIL).CD->eval_at_with_weighted_sum(
-                                          IN_ALPHA, IN_RE, IN_MACH) * IN_MULTIPLIER);
+                const std::array<std::vector<float>, 3> axes{linear_axis(model.min_alpha, model.max_alpha, IN_ALPHA_RESOLUTION),
+                                                             linear_axis(model.min_mach, model.max_mach, IN_MACH_RESOLUTION),
+                                                             geometric_axis(model.min_Re, model.max_Re, IN_RE_RESOLUTION)};
 #else
-            return std::make_pair(this->surrogate_hash_map.at(IN_AIRFOIL).CL->eval_at_with_weighted_sum(IN_ALPHA, IN_RE) * IN_MULTIPLIER,
-                                  this->surrogate_hash_map.at(IN_AIRFOIL).CD->eval_at_with_weighted_sum(IN_ALPHA, IN_RE) * IN_MULTIPLIER);
+                const std::array<std::vector<float>, 2> axes{linear_axis(model.min_alpha, model.max_alpha, IN_ALPHA_RESOLUTION),
+                                                             geometric_axis(model.min_Re, model.max_Re, IN_RE_RESOLUTION)};
 #endif
+                const float cl_deviation = model.CL->bake_grid(axes, true);
+                const float cd_deviation = model.CD->bake_grid(axes, true);
+                model.CD->share_grid_axes(*model.CL);
+                OUT_DEVIATIONS.emplace(name, std::make_pair(cl_deviation, cd_deviation));
+                DEBUG_LOG("Baked lookup tables of airfoil -> " << name << ", estimated max deviation CL: " << cl_deviation
+                          << ", CD: " << cd_deviation);
+            }
+            if (this->query_cache) this->query_cache->clear();
+            return OUT_DEVIATIONS;
+        }
+
+        /**
+         * @brief Fits smoothing spline surrogates of CL and CD over alpha for every built airfoil.
+         *
+         * @details Every Re slice of the polar gets a smoothing cubic spline over alpha, blended in log(Re) between the
+         * slices (see itp::spline_polar). The splines are an alternative to the k-nearest points surrogates for gradient
+         * based optimisers, used through `get_aero_derivatives`.
+         *
+         * @param [in] IN_CL_SMOOTHING Curvature penalty of the CL fits, in deg^3. 0 interpolates the polar.
+         * @param [in] IN_CD_SMOOTHING Curvature penalty of the CD fits, in deg^3.
+         *
+         * @throw std::runtime_error Thrown with mach data, the splines only support (alpha, Re) polars.
+         */
+        void build_spline_surrogates (const float IN_CL_SMOOTHING = 0.1f, const float IN_CD_SMOOTHING = 0.1f) {
+#ifdef USE_MACH_DATA
+            throw std::runtime_error("Spline surrogates are not available with mach data");
+#else
+            for (auto &[name, model] : this->surrogate_hash_map) {
+                if (!model.surrogate_built) continue;
+                const auto size = static_cast<Eigen::Index>(model.CL->get_training_data_size());
+                const auto points = model.CL->get_ptr_trained_data();
+
+                auto cl_spline = std::make_shared<itp::spline_polar>();
+                auto cd_spline = std::make_shared<itp::spline_polar>();
+                cl_spline->build(points->col(0).head(size), points->col(1).head(size), model.CL->get_ptr_func_data()->head(size), IN_CL_SMOOTHING);
+                cd_spline->build(points->col(0).head(size), points->col(1).head(size), model.CD->get_ptr_func_data()->head(size), IN_CD_SMOOTHING);
+                model.CL_spline = std::move(cl_spline);
+                model.CD_spline = std::move(cd_spline);
+            }
+#endif
+        }
+
+        /**
+         * @brief CL, CD and their alpha derivatives of @p IN_AIRFOIL from the spline surrogates, scaled by @p IN_MULTIPLIER.
+         *
+         * @details O(log n) per query. Thread-safe like `get_aero_values`.
+         *
+         * @throw std::runtime_error Thrown if `build_spline_surrogates` was not called for the airfoil.
+         */
+        [[nodiscard]] airfoil_aero_derivatives get_aero_derivatives (const airfoil_id &IN_AIRFOIL, const float &IN_ALPHA, const float &IN_RE,
+                                                                     const float &IN_MULTIPLIER = 1.0f) const {
+            const airfoil_surrogate_model &model = this->built_model(IN_AIRFOIL);
+            if (!model.CL_spline || !model.CD_spline) {
+                throw std::runtime_error("Spline surrogates are not built for airfoil -> " + this->get_airfoil_name(IN_AIRFOIL));
+            }
+            const auto [cl, dcl] = model.CL_spline->eval(IN_ALPHA, IN_RE);
+            const auto [cd, dcd] = model.CD_spline->eval(IN_ALPHA, IN_RE);
+            return airfoil_aero_derivatives{cl * IN_MULTIPLIER, cd * IN_MULTIPLIER, dcl * IN_MULTIPLIER, dcd * IN_MULTIPLIER};
+        }
+
+        [[nodiscard]] airfoil_aero_derivatives get_aero_derivatives (const std::string &IN_AIRFOIL, const float &IN_ALPHA, const float &IN_RE,
+                                                                     const float &IN_MULTIPLIER = 1.0f) const {
+            return this->get_aero_derivatives(this->get_airfoil_id(IN_AIRFOIL), IN_ALPHA, IN_RE, IN_MULTIPLIER);
+        }
+
+        /**
+         * @brief Puts a bounded cache of quantised lookups in front of `get_aero_values`.
+         *
+         * @details Queries are snapped to a grid of @p IN_ALPHA_STEP in alpha, @p IN_RE_RELATIVE_STEP relative in Re and
+         * @p IN_MACH_STEP in mach, and repeated lookups within one cell are answered from the cache. Meant for iterative
+         * solvers (e.g. trim) that re-evaluate the blade stations at nearly identical conditions. Replaces any earlier
+         * cache and its counters.
+         *
+         * @param [in] IN_CAPACITY Maximum number of cached (CL, CD) pairs, least recently used ones are dropped.
+         *
+         * @throw std::invalid_argument Thrown if the capacity or one of the steps is not positive.
+         */
+        void enable_query_cache (const std::size_t IN_CAPACITY = 65536, const float IN_ALPHA_STEP = 0.01f,
+                                 const float IN_RE_RELATIVE_STEP = 0.001f, const float IN_MACH_STEP = 0.001f) {
+            this->query_cache = std::make_shared<concpt::airfoil_query_cache>(IN_CAPACITY, IN_ALPHA_STEP, IN_RE_RELATIVE_STEP, IN_MACH_STEP);
+        }
+
+        void disable_query_cache () noexcept {
+            this->query_cache.reset();
+        }
+
+        /**
+         * @return Hits, misses and size of the query cache, all zero when the cache is disabled.
+         */
+        [[nodiscard]] concpt::airfoil_query_cache::statistics get_query_cache_statistics () const {
+            if (!this->query_cache) return {};
+            return this->query_cache->get_statistics();
+        }
+
+        /**
+         * @brief CL and CD of @p IN_AIRFOIL at the given conditions, scaled by @p IN_MULTIPLIER.
+         *
+         * @note Thread-safe: the method is const and the surrogates are only read, so solver threads can share one
+         * airfoil_polar. Adding airfoils or changing the interpolation mode must not run concurrently with it.
+         */
+        std::pair<float, float> get_aero_values (const airfoil_id &IN_AIRFOIL, const float &IN_ALPHA, const float &IN_RE,
+                                                 const float &IN_MACH = 0.0f, const float &IN_MULTIPLIER = 1.0f) const {
+            const airfoil_surrogate_model &model = this->built_model(IN_AIRFOIL);
+            const auto [cl, cd] = this->query_cache
+                    ? this->query_cache->get_or_compute(&model, IN_ALPHA, IN_RE, IN_MACH,
+                                                        [&model] (const float &IN_C_ALPHA, const float &IN_C_RE, const float &IN_C_MACH) {
+                                                            return evaluate_surrogate(model, IN_C_ALPHA, IN_C_RE, IN_C_MACH);
+                                                        })
+                    : evaluate_surrogate(model, IN_ALPHA, IN_RE, IN_MACH);
+            return std::make_pair(cl * IN_MULTIPLIER, cd * IN_MULTIPLIER);
+        }
+
+        /**
+         * @brief `get_aero_values` by airfoil name, which is hashed once per call. Hot paths should resolve an
+         * airfoil_id with `get_airfoil_id` once and query with it.
+         */
+        std::pair<float, float> get_aero_values (const std::string &IN_AIRFOIL, const float &IN_ALPHA, const float &IN_RE,
+                                                 const float &IN_MACH = 0.0f, const float &IN_MULTIPLIER = 1.0f) const {
+            return this->get_aero_values(this->get_airfoil_id(IN_AIRFOIL), IN_ALPHA, IN_RE, IN_MACH, IN_MULTIPLIER);
+        }
+
+        /**
+         * @brief Sets the command generating the training data of an airfoil. It is run as
+         * `IN_COMMAND... <airfoil> <save path>/<airfoil>` and has to create that directory with the training and
+         * coordinates JSON files, exiting with 0 on success.
+         *
+         * @throw std::invalid_argument Thrown if @p IN_COMMAND is empty.
+         */
+        void set_generator_command (std::vector<std::string> IN_COMMAND) {
+            if (IN_COMMAND.empty()) throw std::invalid_argument("Generator command needs a program");
+            this->generator_command = std::move(IN_COMMAND);
+        }
+
+        /**
+         * @brief Runs the generator for up to @p IN_PROCESSES airfoils at once, trying each failed airfoil up to
+         * @p IN_ATTEMPTS times in total.
+         *
+         * @throw std::invalid_argument Thrown if @p IN_PROCESSES or @p IN_ATTEMPTS is zero.
+         */
+        void set_generation_jobs (const std::size_t IN_PROCESSES, const std::size_t IN_ATTEMPTS = 2) {
+            if (IN_PROCESSES == 0 || IN_ATTEMPTS == 0) throw std::invalid_argument("Generation needs at least one process and one attempt");
+            this->generation_processes = IN_PROCESSES;
+            this->generation_attempts = IN_ATTEMPTS;
+        }
+
+        void set_save_path (std::string IN_SAVE_PATH) {
+            this->save_path = std::move(IN_SAVE_PATH);
+        }
+
+        [[nodiscard]] const std::string& get_save_path () const noexcept {
+            return this->save_path;
         }
 
     private:
+        /** @brief Optional cache of quantised `get_aero_values` lookups, nullptr when disabled */
+        std::shared_ptr<concpt::airfoil_query_cache> query_cache;
+
         std::vector<std::string> airfoil_index;
+
+        /** @brief Entries of surrogate_hash_map in the order they were added, indexed by airfoil_id. Map nodes do not move */
+        std::vector<std::unordered_map<std::string, airfoil_surrogate_model>::value_type*> model_table;
+        std::unordered_map<std::string, airfoil_id> model_ids;
         // path to server locations
-        std::string scriptPath = "/Users/harsha/Desktop/Conceptual/src/airfoil_generator.py";
         std::string save_path = "/Users/harsha/Desktop/Conceptual/assets/airfoil_data";
-        std::string python_path = "/opt/homebrew/bin/python3";
+        /** @brief Generator program and its leading arguments, the airfoil name and its save path are appended */
+        std::vector<std::string> generator_command = {"/opt/homebrew/bin/python3", "/Users/harsha/Desktop/Conceptual/src/airfoil_generator.py"};
+        std::size_t generation_processes = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        std::size_t generation_attempts = 2;
+        bool lazy_build = false;
         std::size_t number_of_airfoils = 0;
         std::size_t num_airfoil_done = 0;
+        bool use_grid_interpolation = true;
 
 
-        void call_python_script (const std::string& IN_CURRENT_AIRFOIL) {
-            std::string current_save_path = this->save_path + "/" + IN_CURRENT_AIRFOIL;
-            if (!std::filesystem::exists(current_save_path)) {
-                DEBUG_LOG("Working on airfoil -> " << IN_CURRENT_AIRFOIL << ". [" << this->num_airfoil_done << "/" << this->number_of_airfoils << "]");
-                std::string CL_command = this->python_path + " " + this->scriptPath + " " + IN_CURRENT_AIRFOIL + " " + current_save_path;
-                int result = system(CL_command.c_str());
-                if (result != 0) {
-                    std::cerr << "Error executing the Python script with airfoil name -> " << IN_CURRENT_AIRFOIL
-                              << ", and save path ->" << current_save_path << std::endl;
-                } else {
-                    std::cout << "Completed airfoil -> " << IN_CURRENT_AIRFOIL << ", saved at -> " << current_save_path << std::endl;
-                    this->num_airfoil_done++;
-                }
-            } else {
-                DEBUG_LOG("Current airfoil (" << IN_CURRENT_AIRFOIL << ") training data already exits");
-                DEBUG_LOG("Skipping current airfoil");
-                this->num_airfoil_done++;
-            }
+        /**
+         * @brief Serialises the console output of airfoil builds, which run concurrently in `build_surrogate_models`
+         * and in lazy mode, so that their lines do not interleave.
+         */
+        static std::mutex& output_mutex () {
+            static std::mutex mutex;
+            return mutex;
         }
 
         void build_training_data () {
-            for (auto& current_airfoil : this->airfoil_index) {
-                this->call_python_script(current_airfoil);
-            }
+            this->num_airfoil_done = this->generate_training_data(this->airfoil_index);
             if (this->num_airfoil_done == this->number_of_airfoils) {
                 DEBUG_LOG("Build training data for all airfoils...");
             }
             else std::cerr << "Not all airfoils' training data build. Check log..." << std::endl;
         }
 
+        /**
+         * @brief Generates the training data of the airfoils of @p IN_AIRFOILS that have none yet, running the
+         * generator for up to `generation_processes` airfoils at once.
+         *
+         * @details The generator is called as `generator_command... <airfoil> <save path>/<airfoil>` and its output goes
+         * to `<save path>/<airfoil>_generation.log`. Failed runs are retried up to `generation_attempts` times in total.
+         *
+         * @return Number of airfoils of @p IN_AIRFOILS with training data.
+         */
+        std::size_t generate_training_data (const std::vector<std::string> &IN_AIRFOILS) const {
+            std::vector<concpt::declare::job_runner::job> jobs;
+            std::size_t OUT_DONE = 0;
+            for (const auto &current_airfoil : IN_AIRFOILS) {
+                const std::string current_save_path = this->save_path + "/" + current_airfoil;
+                if (std::filesystem::exists(current_save_path)) {
+                    const std::lock_guard<std::mutex> lock(output_mutex());
+                    DEBUG_LOG("Current airfoil (" << current_airfoil << ") training data already exits");
+                    DEBUG_LOG("Skipping current airfoil");
+                    OUT_DONE++;
+                    continue;
+                }
+                std::vector<std::string> command = this->generator_command;
+                command.push_back(current_airfoil);
+                command.push_back(current_save_path);
+                jobs.push_back({current_airfoil, std::move(command), this->save_path + "/" + current_airfoil + "_generation.log"});
+            }
+            if (jobs.empty()) return OUT_DONE;
+
+            std::filesystem::create_directories(this->save_path);
+            concpt::declare::job_runner runner(this->generation_processes, this->generation_attempts);
+            const std::size_t already_done = OUT_DONE;
+            runner.set_progress_callback([&IN_AIRFOILS, &already_done] (const concpt::declare::job_runner::progress &IN_PROGRESS) {
+                const std::lock_guard<std::mutex> lock(output_mutex());
+                DEBUG_LOG("Generating training data: [" << already_done + IN_PROGRESS.succeeded << "/" << IN_AIRFOILS.size()
+                          << "] done, " << IN_PROGRESS.running << " running, " << IN_PROGRESS.retried << " retried, "
+                          << IN_PROGRESS.failed << " failed");
+            });
+
+            for (const auto &result : runner.run(jobs)) {
+                const std::lock_guard<std::mutex> lock(output_mutex());
+                if (result.succeeded()) {
+                    std::cout << "Completed airfoil -> " << result.name << ", saved at -> " << this->save_path + "/" + result.name << std::endl;
+                    OUT_DONE++;
+                } else {
+                    std::cerr << "Error generating training data of airfoil -> " << result.name << " after " << result.attempts
+                              << " attempts, exit code " << result.exit_code << ". See " << this->save_path + "/" + result.name + "_generation.log" << std::endl;
+                }
+            }
+            return OUT_DONE;
+        }
+
+        /**
+         * @brief Builds the surrogates of every airfoil concurrently on the shared thread pool.
+         *
+         * @details The airfoils are independent: each task only touches its own entry of the hash map, whose layout is
+         * fixed by `build_hash_map` beforehand. The pool bounds the number of polars held in memory at once. All output
+         * of the builds is serialised through `output_mutex` so that it does not interleave.
+         *
+         * @throw Rethrows the first failure of an airfoil, after every airfoil has been attempted.
+         */
         void build_surrogate_models () {
-            this->num_airfoil_done = 0;
-            for (auto& each_airfoil : this->airfoil_index) {
-                DEBUG_LOG("Building Surrogate Models of airfoil -> " << each_airfoil << " [" << this->num_airfoil_done++ << "/"
-                                                                     << this->number_of_airfoils << "]");
-                this->build_surrogate_model_at(each_airfoil);
-                DEBUG_LOG("Surrogate Build Complete for airfoil -> " << each_airfoil);
+            std::atomic<std::size_t> completed{0};
+            auto report = [this] (const std::string &IN_MESSAGE, const std::size_t IN_DONE) {
+                const std::lock_guard<std::mutex> lock(output_mutex());
+                DEBUG_LOG(IN_MESSAGE << " [" << IN_DONE << "/" << this->number_of_airfoils << "]");
+            };
+
+            concpt::declare::thread_pool &pool = concpt::declare::thread_pool::shared();
+            pool.parallel_for(0, this->airfoil_index.size(), this->airfoil_index.size(), [&] (const std::size_t IN_BEGIN, const std::size_t IN_END) {
+                for (std::size_t i = IN_BEGIN; i < IN_END; i++) {
+                    const std::string &each_airfoil = this->airfoil_index[i];
+                    report("Building Surrogate Models of airfoil -> " + each_airfoil, completed.load(std::memory_order_relaxed));
+                    this->build_airfoil_once(each_airfoil, this->surrogate_hash_map.at(each_airfoil));
+                    report("Surrogate Build Complete for airfoil -> " + each_airfoil, completed.fetch_add(1, std::memory_order_relaxed) + 1);
+                }
+            });
+            this->num_airfoil_done = completed.load();
+        }
 
+        /**
+         * @brief Builds @p OUT_MODEL through its build state: the first caller builds it, concurrent callers wait, and
+         * the failure of the build is stored and rethrown to every caller.
+         */
+        void build_airfoil_once (const std::string &IN_CURRENT_AIRFOIL, airfoil_surrogate_model &OUT_MODEL) {
+            airfoil_surrogate_model::build_state &state = *OUT_MODEL.build;
+            std::call_once(state.once, [this, &IN_CURRENT_AIRFOIL, &state] {
                 try {
-                    this->get_airfoil_coordinates(each_airfoil);
-                } catch (std::exception &e) {
-                    std::cerr << e.what() << std::endl;
-                    std::cerr << "Skipping coordinates capture..." << std::endl;
+                    this->build_airfoil(IN_CURRENT_AIRFOIL);
+                } catch (...) {
+                    state.error = std::current_exception();
                 }
+            });
+            if (state.error) std::rethrow_exception(state.error);
+        }
+
+        /**
+         * @brief Builds the surrogates and reads the coordinates of one airfoil, generating its training data first in
+         * lazy mode. Only called through `build_airfoil_once`.
+         */
+        void build_airfoil (const std::string &IN_CURRENT_AIRFOIL) {
+            if (this->lazy_build) this->generate_training_data({IN_CURRENT_AIRFOIL});
+            this->build_surrogate_model_at(IN_CURRENT_AIRFOIL);
+
+            try {
+                this->get_airfoil_coordinates(IN_CURRENT_AIRFOIL);
+            } catch (std::exception &e) {
+                const std::lock_guard<std::mutex> lock(output_mutex());
+                std::cerr << e.what() << std::endl;
+                std::cerr << "Skipping coordinates capture..." << std::endl;
             }
         }
 
+        /**
+         * @brief Model of @p IN_AIRFOIL for the const query methods, built first in lazy mode.
+         *
+         * @details A lazy build only fills the entry of the airfoil, which the query methods treat as a cache: the
+         * set of airfoils and the layout of the hash map do not change.
+         */
+        const airfoil_surrogate_model& built_model (const airfoil_id &IN_AIRFOIL) const {
+            if (!this->lazy_build) return this->model_table.at(IN_AIRFOIL.value)->second;
+            return const_cast<airfoil_polar*>(this)->hash_airfoil(IN_AIRFOIL);
+        }
+
         void build_surrogate_model_at (const std::string& IN_CURRENT_AIRFOIL) {
             if (this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).surrogate_built) {
                 return;
@@ -196,36 +638,48 @@ namespace concpt {
                 std::size_t number_of_mach;
 #endif
                 const std::string current_airfoil_path = this->save_path + "/" + IN_CURRENT_AIRFOIL + "/" + IN_CURRENT_AIRFOIL + "_training" + ".json";
-                std::ifstream data_file(current_airfoil_path, std::ios::ate);
-
-                if (!data_file.is_open() && data_file.tellg() != 0) {
-                    throw std::runtime_error("Could not open file for reading or it is empty: " + current_airfoil_path);
-                }
-                data_file.seekg(0, std::ios::beg);
-                const nlohmann::json json_data = nlohmann::json::parse(data_file);
-                data_file.close();
+                const std::string current_cache_path = this->save_path + "/" + IN_CURRENT_AIRFOIL + "/" + IN_CURRENT_AIRFOIL + "_training" + ".polar";
 
                 try {
-                    if (!(json_data.contains("CL") && json_data.contains("CD") && json_data.contains("Re") &&
-                          json_data.contains("alpha") && json_data.contains("mach"))) {
-                        throw std::runtime_error("JSON Data structure is unexpected...");
-                    }
-                    if (!(json_data["CL"].is_array() && json_data["CD"].is_array() && json_data["Re"].is_array() &&
-                          json_data["alpha"].is_array() && json_data["mach"].is_array())) {
-                        throw std::runtime_error("JSON Data datatype is unknown...");
-                    }
-                    CL_ = json_data.at("CL").get<std::vector<float>>();
-                    CD_ = json_data.at("CD").get<std::vector<float>>();
-                    alpha_ = json_data.at("alpha").get<std::vector<float>>();
-                    Re_ = json_data.at("Re").get<std::vector<float>>();
-
-                    {
-                        std::set<float> uniq_RE(Re_.begin(), Re_.end());
-                        std::set<float> uniq_ALPHA(alpha_.begin(), alpha_.end());
-                        number_of_alpha = uniq_ALPHA.size();
-                        number_of_Re = uniq_RE.size();
+#ifdef USE_MACH_DATA
+                    const std::vector<concpt::polar_cache::column> columns{{"CL", &CL_}, {"CD", &CD_}, {"alpha", &alpha_}, {"Re", &Re_}, {"mach", &mach_}};
+#else
+                    const std::vector<concpt::polar_cache::column> columns{{"CL", &CL_}, {"CD", &CD_}, {"alpha", &alpha_}, {"Re", &Re_}};
+#endif
+                    std::vector<concpt::polar_axis> axes;
+                    if (concpt::polar_cache::read(current_cache_path, current_airfoil_path, columns, axes)) {
+                        const std::lock_guard<std::mutex> lock(output_mutex());
+                        DEBUG_LOG("Loaded training data of airfoil -> " << IN_CURRENT_AIRFOIL << " from polar cache");
+                    } else {
+                        std::ifstream data_file(current_airfoil_path, std::ios::ate);
+
+                        if (!data_file.is_open() && data_file.tellg() != 0) {
+                            throw std::runtime_error("Could not open file for reading or it is empty: " + current_airfoil_path);
+                        }
+                        data_file.seekg(0, std::ios::beg);
+
+#ifdef USE_MACH_DATA
+                        concpt::polar_json_reader::read(data_file, {{"CL", &CL_}, {"CD", &CD_}, {"alpha", &alpha_}, {"Re", &Re_}, {"mach", &mach_}});
+#else
+                        concpt::polar_json_reader::read(data_file, {{"CL", &CL_}, {"CD", &CD_}, {"alpha", &alpha_}, {"Re", &Re_}, {"mach", nullptr}});
+#endif
+                        data_file.close();
+
+                        axes.clear();
+                        for (const auto &each : columns) axes.push_back(concpt::polar_cache::describe(*each.second));
+                        try {
+                            concpt::polar_cache::write(current_cache_path, current_airfoil_path, columns, axes);
+                        } catch (std::exception &e) {
+                            const std::lock_guard<std::mutex> lock(output_mutex());
+                            std::cerr << e.what() << std::endl;
+                            std::cerr << "Skipping polar cache write..." << std::endl;
+                        }
                     }
 
+                    // axes follow the order of columns: CL, CD, alpha, Re, mach
+                    number_of_alpha = axes[2].unique;
+                    number_of_Re = axes[3].unique;
+
 #ifndef USE_MACH_DATA
                     CL_.resize(number_of_alpha * number_of_Re);
                     CD_.resize(number_of_alpha * number_of_Re);
@@ -234,11 +688,7 @@ namespace concpt {
 #endif
 
 #ifdef USE_MACH_DATA
-                    mach_ = json_data.at("mach").get<std::vector<float>>();
-                    {
-                        std::set<float> uniq_MACH(mach_.begin(), mach_.end());
-                        number_of_mach = uniq_MACH.size();
-                    };
+                    number_of_mach = axes[4].unique;
 
                     std::tie(positive_stall, negative_stall, unique_re, unique_mach) = this->get_stall_angles(CL_, Re_, alpha_, number_of_alpha, number_of_Re, number_of_mach, mach_);
                     max_cl_cd = this->get_max_cl_cd_angles(CL_, CD_, Re_, alpha_, number_of_alpha, number_of_Re, number_of_mach, mach_);
@@ -253,19 +703,33 @@ namespace concpt {
 
                 try {
 #ifndef EIGEN_USE_DYNAMIC
+                    // The training points are stored once, in CL and positive_stall. The other models are linked to
+                    // them while still empty and only write their function values.
+                    auto &model = this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL);
+                    model.CD->set_ptr_trained_data(model.CL->get_ptr_trained_data());
+                    model.negative_stall->set_ptr_trained_data(model.positive_stall->get_ptr_trained_data());
+                    model.max_cl_cd_angle->set_ptr_trained_data(model.positive_stall->get_ptr_trained_data());
+
+                    model.CL->reserve(CL_.size());
+                    model.positive_stall->reserve(positive_stall.size());
     #ifdef USE_MACH_DATA
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CL->add_training_data<500000>(CL_, alpha_, mach_, Re_);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CD->add_training_data<500000>(CD_, alpha_, mach_, Re_);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).positive_stall->add_training_data<5000>(positive_stall, unique_mach, unique_re);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).negative_stall->add_training_data<5000>(negative_stall, unique_mach, unique_re);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_cl_cd_angle->add_training_data<5000>(max_cl_cd, unique_mach, unique_re);
+                    model.CL->append_training_data(CL_, alpha_, mach_, Re_);
+                    model.positive_stall->append_training_data(positive_stall, unique_mach, unique_re);
     #else
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CL->add_training_data<50000>(CL_, alpha_, Re_);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CD->add_training_data<50000>(CD_, alpha_, Re_);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).positive_stall->add_training_data<500>(positive_stall, unique_re);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).negative_stall->add_training_data<500>(negative_stall, unique_re);
-                    this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_cl_cd_angle->add_training_data<500>(max_cl_cd, unique_re);
+                    model.CL->append_training_data(CL_, alpha_, Re_);
+                    model.positive_stall->append_training_data(positive_stall, unique_re);
     #endif
+                    model.CD->append_function_data(CD_);
+                    model.negative_stall->append_function_data(negative_stall);
+                    model.max_cl_cd_angle->append_function_data(max_cl_cd);
+
+                    model.CL->finish_training_data();
+                    model.CD->finish_training_data();
+                    model.positive_stall->finish_training_data();
+                    model.negative_stall->set_ptr_sorted(model.positive_stall->get_ptr_sorted());
+                    model.max_cl_cd_angle->set_ptr_sorted(model.positive_stall->get_ptr_sorted());
+                    model.negative_stall->finish_training_data();
+                    model.max_cl_cd_angle->finish_training_data();
 #else
     #ifdef USUSE_MACH_DATA
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CL->add_training_data(CL_, alpha_, mach_, Re_);
@@ -280,11 +744,10 @@ namespace concpt {
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).negative_stall->add_training_data(negative_stall, unique_re);
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_cl_cd_angle->add_training_data(max_cl_cd, unique_re);
     #endif
-
-#endif
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).negative_stall->set_ptr_trained_data(this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).positive_stall->get_ptr_trained_data());
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_cl_cd_angle->set_ptr_trained_data(this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).positive_stall->get_ptr_trained_data());
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CD->set_ptr_trained_data(this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).CL->get_ptr_trained_data());
+#endif
 
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_CL = *std::ranges::max_element(CL_.begin(), CL_.end());
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_CD = *std::ranges::max_element(CD_.begin(), CD_.end());
@@ -311,12 +774,14 @@ namespace concpt {
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).negative_stall->add_major_axis_factors(0.1f);
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).max_cl_cd_angle->add_major_axis_factors(0.1f);
 
+                    this->build_query_structures(this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL));
 
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).surrogate_built = true;
                 } catch (std::exception &e) {
                     throw std::runtime_error("Error while inputting training data to surrogate model");
                 }
             } catch (std::exception &e) {
+                const std::lock_guard<std::mutex> lock(output_mutex());
                 std::cerr << e.what() << std::endl;
                 std::cerr << "Error while converting JSON -> Eigen data..." << std::endl;
                 throw;
@@ -324,10 +789,37 @@ namespace concpt {
         }
 
 
+        static std::pair<float, float> evaluate_surrogate (const airfoil_surrogate_model &IN_MODEL, const float &IN_ALPHA,
+                                                           const float &IN_RE, [[maybe_unused]] const float &IN_MACH) {
+#ifdef USE_MACH_DATA
+            const auto [cl, cd] = IN_MODEL.CL->eval_many(Eigen::Vector3f(IN_ALPHA, IN_RE, IN_MACH), true, *IN_MODEL.CD);
+#else
+            const auto [cl, cd] = IN_MODEL.CL->eval_many(Eigen::Vector2f(IN_ALPHA, IN_RE), true, *IN_MODEL.CD);
+#endif
+            return std::make_pair(cl, cd);
+        }
+
+        void build_query_structures (airfoil_surrogate_model &IN_MODEL) {
+            if (this->use_grid_interpolation && IN_MODEL.CL->build_grid() && IN_MODEL.CD->build_grid()) {
+                IN_MODEL.CL->clear_index();
+                IN_MODEL.CD->clear_index();
+                IN_MODEL.CD->share_grid_axes(*IN_MODEL.CL);
+                return;
+            }
+            IN_MODEL.CL->clear_grid();
+            IN_MODEL.CD->clear_grid();
+            if (!IN_MODEL.CL->has_index()) IN_MODEL.CL->build_index();
+            IN_MODEL.CD->set_ptr_index(IN_MODEL.CL->get_ptr_index());
+        }
+
         void build_hash_map () {
             DEBUG_LOG("Generating airfoil surrogate model skeleton hash map...");
-            for (auto& each_airfoil : this->airfoil_index)
-                this->surrogate_hash_map.try_emplace(each_airfoil, airfoil_surrogate_model());
+            for (auto& each_airfoil : this->airfoil_index) {
+                const auto [entry, inserted] = this->surrogate_hash_map.try_emplace(each_airfoil);
+                if (!inserted) continue;
+                this->model_ids.emplace(each_airfoil, airfoil_id(static_cast<std::uint32_t>(this->model_table.size())));
+                this->model_table.push_back(&*entry);
+            }
         }
 
         std::vector<float>::iterator get_stall_angles_helper (std::vector<float>::iterator IN_START, std::vector<float>::iterator IN_END, const bool positive_angle = true) {
@@ -348,7 +840,10 @@ namespace concpt {
                 previous = current;
                 std::ranges::advance(current, (positive_angle ? 1 : -1));
             }
-            std::cerr << "Failed to find the stall angle..." << std::endl;
+            {
+                const std::lock_guard<std::mutex> lock(output_mutex());
+                std::cerr << "Failed to find the stall angle..." << std::endl;
+            }
             return IN_END;
         }
 
@@ -395,7 +890,10 @@ namespace concpt {
                 std::ranges::advance(current_cl, 1);
                 std::ranges::advance(current_cd, 1);
             }
-            std::cerr << "Failed to find the max cl-by-cd angle..." << std::endl;
+            {
+                const std::lock_guard<std::mutex> lock(output_mutex());
+                std::cerr << "Failed to find the max cl-by-cd angle..." << std::endl;
+            }
             return IN_END_CL;
         }
 
@@ -459,6 +957,7 @@ namespace concpt {
                     this->surrogate_hash_map.at(IN_CURRENT_AIRFOIL).airfoil_coordinates_lower.emplace_back(lower_coordinates_x[i] - 0.5f, lower_coordinates_y[i]);
                 }
             } catch (std::exception &e) {
+                const std::lock_guard<std::mutex> lock(output_mutex());
                 std::cerr << e.what() << std::endl;
                 std::cerr << "Error while attaching converting JSON coordinates to vector data..." << std::endl;
             }
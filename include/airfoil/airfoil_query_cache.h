@@ -0,0 +1,150 @@
+//
+// Created by Harshavardhan Karnati on 17/10/2026.
+//
+
+#ifndef CONCEPTUAL_AIRFOIL_QUERY_CACHE_H
+#define CONCEPTUAL_AIRFOIL_QUERY_CACHE_H
+
+#include <iostream>
+#include <list>
+#include <unordered_map>
+#include <utility>
+#include <mutex>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+namespace concpt {
+    /**
+     * @class airfoil_query_cache
+     * @brief Bounded least-recently-used cache of surrogate (CL, CD) lookups on a quantised (alpha, Re, mach) grid.
+     *
+     * @details Alpha and mach are quantised with absolute steps, Re with a relative step (uniform in log Re). Every
+     * query is snapped to the centre of its quantisation cell and the surrogate is evaluated there, so a cached result
+     * does not depend on which query of the cell came first. The quantisation error is bounded by half a step per axis.
+     *
+     * @note Thread-safe. Lookups and inserts are guarded by a mutex, the surrogate evaluation of a miss runs outside it.
+     */
+    class airfoil_query_cache {
+    public:
+        struct statistics {
+            std::size_t hits = 0;
+            std::size_t misses = 0;
+            std::size_t size = 0;
+        };
+
+        /**
+         * @param [in] IN_CAPACITY Maximum number of cached results. The least recently used one is dropped beyond it.
+         * @param [in] IN_ALPHA_STEP Quantisation step of the angle of attack.
+         * @param [in] IN_RE_RELATIVE_STEP Relative quantisation step of the Reynolds number, e.g. 0.001 for 0.1 %.
+         * @param [in] IN_MACH_STEP Quantisation step of the mach number.
+         *
+         * @throw std::invalid_argument Thrown if the capacity or one of the steps is not positive.
+         */
+        airfoil_query_cache (const std::size_t IN_CAPACITY, const float IN_ALPHA_STEP, const float IN_RE_RELATIVE_STEP,
+                             const float IN_MACH_STEP) : capacity(IN_CAPACITY), alpha_step(IN_ALPHA_STEP),
+                                                         log_re_step(std::log1p(IN_RE_RELATIVE_STEP)), mach_step(IN_MACH_STEP) {
+            if (IN_CAPACITY == 0 || !(IN_ALPHA_STEP > 0.0f) || !(IN_RE_RELATIVE_STEP > 0.0f) || !(IN_MACH_STEP > 0.0f)) {
+                throw std::invalid_argument("Query cache capacity and quantisation steps need to be positive");
+            }
+        }
+
+        virtual ~airfoil_query_cache () = default;
+
+        /**
+         * @brief Returns the cached (CL, CD) of the quantisation cell of the query, computing it on a miss.
+         *
+         * @param [in] IN_MODEL Identity of the surrogate model queried, part of the key.
+         * @param [in] IN_ALPHA Angle of attack.
+         * @param [in] IN_RE Reynolds number.
+         * @param [in] IN_MACH Mach number.
+         * @param [in] IN_COMPUTE Called as IN_COMPUTE(alpha, Re, mach) with the snapped query on a miss.
+         */
+        template <class function_type>
+        std::pair<float, float> get_or_compute (const void *IN_MODEL, const float &IN_ALPHA, const float &IN_RE,
+                                                const float &IN_MACH, const function_type &IN_COMPUTE) {
+            const key current{IN_MODEL, quantise(IN_ALPHA, this->alpha_step),
+                              quantise(std::log(std::max(IN_RE, std::numeric_limits<float>::min())), this->log_re_step),
+                              quantise(IN_MACH, this->mach_step)};
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                const auto it = this->lookup.find(current);
+                if (it != this->lookup.end()) {
+                    this->hits++;
+                    this->entries.splice(this->entries.begin(), this->entries, it->second);
+                    return it->second->second;
+                }
+                this->misses++;
+            }
+
+            const std::pair<float, float> OUT_VALUES = IN_COMPUTE(
+                    static_cast<float>(static_cast<double>(current.alpha) * this->alpha_step),
+                    static_cast<float>(std::exp(static_cast<double>(current.re) * this->log_re_step)),
+                    static_cast<float>(static_cast<double>(current.mach) * this->mach_step));
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (this->lookup.contains(current)) return OUT_VALUES;
+            this->entries.emplace_front(current, OUT_VALUES);
+            this->lookup.emplace(current, this->entries.begin());
+            if (this->entries.size() > this->capacity) {
+                this->lookup.erase(this->entries.back().first);
+                this->entries.pop_back();
+            }
+            return OUT_VALUES;
+        }
+
+        [[nodiscard]] statistics get_statistics () const {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            return statistics{this->hits, this->misses, this->entries.size()};
+        }
+
+        /**
+         * @brief Drops all cached results and resets the counters. Needed whenever the surrogates change.
+         */
+        void clear () {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->entries.clear();
+            this->lookup.clear();
+            this->hits = 0;
+            this->misses = 0;
+        }
+
+    private:
+        struct key {
+            const void *model;
+            std::int64_t alpha, re, mach;
+
+            bool operator== (const key &IN_OTHER) const noexcept = default;
+        };
+
+        struct key_hash {
+            std::size_t operator() (const key &IN_KEY) const noexcept {
+                std::size_t seed = std::hash<const void*>()(IN_KEY.model);
+                for (const std::int64_t value : {IN_KEY.alpha, IN_KEY.re, IN_KEY.mach}) {
+                    seed ^= std::hash<std::int64_t>()(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+                }
+                return seed;
+            }
+        };
+
+        using entry = std::pair<key, std::pair<float, float>>;
+
+        std::size_t capacity;
+        double alpha_step, log_re_step, mach_step;
+
+        /** @brief Cached results, most recently used first */
+        std::list<entry> entries;
+        std::unordered_map<key, std::list<entry>::iterator, key_hash> lookup;
+        std::size_t hits = 0, misses = 0;
+        mutable std::mutex mutex;
+
+        static std::int64_t quantise (const double IN_VALUE, const double IN_STEP) noexcept {
+            return static_cast<std::int64_t>(std::llround(IN_VALUE / IN_STEP));
+        }
+    };
+}
+
+#endif //CONCEPTUAL_AIRFOIL_QUERY_CACHE_H
@@ -0,0 +1,239 @@
+//
+// Created by Harshavardhan Karnati on 17/10/2026.
+//
+
+#ifndef CONCEPTUAL_POLAR_CACHE_H
+#define CONCEPTUAL_POLAR_CACHE_H
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <array>
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+
+#include "training_store.h"
+
+namespace concpt {
+    static_assert(std::numeric_limits<float>::is_iec559, "Polar caches hold IEEE 754 single precision floats");
+
+    /**
+     * @brief Summary of one polar column, stored with it so that loading a cache needs no pass over the values.
+     */
+    struct polar_axis {
+        float min = 0.0f;
+        float max = 0.0f;
+
+        /** @brief Number of distinct values of the column */
+        std::uint64_t unique = 0;
+    };
+
+    /**
+     * @class polar_cache
+     * @brief Compact binary copy of the numeric columns of a polar training JSON, preferred over parsing the JSON.
+     *
+     * @details Layout (native byte order, which is recorded and checked):
+     *  - header, 64 bytes: magic, version, byte order, column count, row count, size and modification time of the
+     *    source JSON, and a checksum of everything after the header.
+     *  - column table, 32 bytes per column: name and polar_axis.
+     *  - column values, `row count` floats per column, one column after another.
+     * A cache is used only if it is complete, its checksum matches and the source JSON has the recorded size and
+     * modification time, so editing or regenerating the JSON makes the cache stale and it is rewritten on the next load.
+     * Caches are written to a temporary file unique to the writer and renamed into place, so a reader never sees a
+     * partial file and concurrent writers of the same cache do not interfere.
+     */
+    class polar_cache {
+    public:
+        /** @brief Cached column name and the vector holding its values */
+        using column = std::pair<std::string, std::vector<float>*>;
+
+        /**
+         * @brief Reads the requested columns from the cache at @p IN_CACHE_PATH if it is valid for @p IN_SOURCE_PATH.
+         *
+         * @param [in] IN_CACHE_PATH Binary polar cache.
+         * @param [in] IN_SOURCE_PATH JSON the cache was written from.
+         * @param [in] IN_COLUMNS Requested columns, filled only if the cache is valid and holds all of them.
+         * @param [out] OUT_AXES Summary of every requested column, in the order of @p IN_COLUMNS.
+         *
+         * @return false if the cache is missing, stale, corrupt or lacks a requested column.
+         */
+        static bool read (const std::filesystem::path &IN_CACHE_PATH, const std::filesystem::path &IN_SOURCE_PATH,
+                          const std::vector<column> &IN_COLUMNS, std::vector<polar_axis> &OUT_AXES) {
+            std::error_code error;
+            const auto cache_size = std::filesystem::file_size(IN_CACHE_PATH, error);
+            if (error || cache_size < sizeof(header)) return false;
+
+            std::ifstream file(IN_CACHE_PATH, std::ios::binary);
+            header stored{};
+            if (!file.read(reinterpret_cast<char*>(&stored), sizeof(stored))) return false;
+            if (stored.magic != cache_magic || stored.version != cache_version || stored.byte_order != cache_byte_order) return false;
+            if (stored.column_count > max_columns || stored.row_count > (cache_size - sizeof(header)) / sizeof(float)) return false;
+
+            const source_stamp stamp = stamp_of(IN_SOURCE_PATH);
+            if (stamp.size != stored.source_size || stamp.time != stored.source_time) return false;
+
+            const std::uint64_t table_bytes = stored.column_count * sizeof(entry);
+            if (cache_size - sizeof(header) != table_bytes + stored.column_count * stored.row_count * sizeof(float)) return false;
+
+            std::vector<entry> table(stored.column_count);
+            if (!file.read(reinterpret_cast<char*>(table.data()), static_cast<std::streamsize>(table_bytes))) return false;
+            std::uint64_t checksum = hash(table.data(), table_bytes, hash_seed);
+
+            std::vector<std::vector<float>> values(stored.column_count);
+            for (std::size_t c = 0; c < stored.column_count; c++) {
+                values[c].resize(static_cast<std::size_t>(stored.row_count));
+                const auto bytes = static_cast<std::streamsize>(stored.row_count * sizeof(float));
+                if (!file.read(reinterpret_cast<char*>(values[c].data()), bytes)) return false;
+                checksum = hash(values[c].data(), static_cast<std::size_t>(bytes), checksum);
+            }
+            if (checksum != stored.checksum) return false;
+
+            std::vector<std::size_t> positions(IN_COLUMNS.size());
+            for (std::size_t i = 0; i < IN_COLUMNS.size(); i++) {
+                const auto found = std::find_if(table.begin(), table.end(), [&IN_COLUMNS, &i] (const entry &IN_ENTRY) -> bool {
+                    return name_of(IN_ENTRY) == IN_COLUMNS[i].first;
+                });
+                if (found == table.end()) return false;
+                positions[i] = static_cast<std::size_t>(std::distance(table.begin(), found));
+            }
+
+            OUT_AXES.resize(IN_COLUMNS.size());
+            for (std::size_t i = 0; i < IN_COLUMNS.size(); i++) {
+                OUT_AXES[i] = table[positions[i]].axis;
+                if (IN_COLUMNS[i].second != nullptr) *IN_COLUMNS[i].second = std::move(values[positions[i]]);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Writes the columns to a cache at @p IN_CACHE_PATH, stamped with the current state of @p IN_SOURCE_PATH.
+         *
+         * @param [in] IN_AXES Summary of every column, as returned by `describe`.
+         *
+         * @throw std::invalid_argument Thrown if the columns differ in length, a name is too long or an axis is missing.
+         * @throw std::runtime_error Thrown if the cache cannot be written.
+         */
+        static void write (const std::filesystem::path &IN_CACHE_PATH, const std::filesystem::path &IN_SOURCE_PATH,
+                           const std::vector<column> &IN_COLUMNS, const std::vector<polar_axis> &IN_AXES) {
+            if (IN_COLUMNS.size() > max_columns || IN_AXES.size() != IN_COLUMNS.size()) {
+                throw std::invalid_argument("Polar cache needs one axis summary for each of at most " + std::to_string(max_columns) + " columns");
+            }
+            const std::size_t rows = IN_COLUMNS.empty() ? 0 : IN_COLUMNS.front().second->size();
+            std::vector<entry> table(IN_COLUMNS.size());
+            for (std::size_t i = 0; i < IN_COLUMNS.size(); i++) {
+                if (IN_COLUMNS[i].second->size() != rows) throw std::invalid_argument("Polar cache columns need to have the same size");
+                if (IN_COLUMNS[i].first.size() > table[i].name.size()) throw std::invalid_argument("Polar cache column name is too long: " + IN_COLUMNS[i].first);
+                std::copy(IN_COLUMNS[i].first.begin(), IN_COLUMNS[i].first.end(), table[i].name.begin());
+                table[i].axis = IN_AXES[i];
+            }
+
+            const source_stamp stamp = stamp_of(IN_SOURCE_PATH);
+            header written{cache_magic, cache_version, cache_byte_order, static_cast<std::uint32_t>(IN_COLUMNS.size()), 0, rows,
+                           stamp.size, stamp.time, hash(table.data(), table.size() * sizeof(entry), hash_seed), 0};
+            for (const column &each : IN_COLUMNS) {
+                written.checksum = hash(each.second->data(), rows * sizeof(float), written.checksum);
+            }
+
+            const std::filesystem::path temporary_path = itp::temporary_path_for(IN_CACHE_PATH);
+            {
+                std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(&written), sizeof(written));
+                file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(entry)));
+                for (const column &each : IN_COLUMNS) {
+                    file.write(reinterpret_cast<const char*>(each.second->data()), static_cast<std::streamsize>(rows * sizeof(float)));
+                }
+                file.close();
+                if (file.fail()) {
+                    std::error_code error;
+                    std::filesystem::remove(temporary_path, error);
+                    throw std::runtime_error("Could not write polar cache: " + temporary_path.string());
+                }
+            }
+            std::filesystem::rename(temporary_path, IN_CACHE_PATH);
+        }
+
+        /**
+         * @brief Summarises @p IN_VALUES: its range and number of distinct values, as std::set<float> would count them.
+         */
+        static polar_axis describe (const std::vector<float> &IN_VALUES) {
+            if (IN_VALUES.empty()) return {};
+            std::vector<float> sorted(IN_VALUES);
+            std::sort(sorted.begin(), sorted.end());
+            const auto unique = static_cast<std::uint64_t>(std::distance(sorted.begin(), std::unique(sorted.begin(), sorted.end())));
+            return polar_axis{sorted.front(), sorted[static_cast<std::size_t>(unique) - 1], unique};
+        }
+
+    private:
+        struct header {
+            std::array<char, 8> magic;
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint32_t column_count;
+            std::uint32_t reserved;
+            std::uint64_t row_count;
+            std::uint64_t source_size;
+            std::int64_t source_time;
+            std::uint64_t checksum;
+            std::uint64_t padding;
+        };
+
+        struct entry {
+            std::array<char, 16> name{};
+            polar_axis axis;
+        };
+
+        struct source_stamp {
+            std::uint64_t size = 0;
+            std::int64_t time = 0;
+        };
+
+        static_assert(sizeof(header) == 64 && std::is_trivially_copyable_v<header>);
+        static_assert(sizeof(entry) == 32 && std::is_trivially_copyable_v<entry>);
+
+        static constexpr std::array<char, 8> cache_magic{'C', 'P', 'T', 'P', 'O', 'L', 'A', 'R'};
+        static constexpr std::uint32_t cache_version = 1;
+        static constexpr std::uint32_t cache_byte_order = 0x01020304;
+        static constexpr std::uint32_t max_columns = 16;
+        static constexpr std::uint64_t hash_seed = 0xcbf29ce484222325ULL;
+
+        /** @brief Size and modification time of the source, both zero if it does not exist */
+        static source_stamp stamp_of (const std::filesystem::path &IN_SOURCE_PATH) {
+            std::error_code error;
+            source_stamp OUT_STAMP;
+            OUT_STAMP.size = std::filesystem::file_size(IN_SOURCE_PATH, error);
+            if (error) return {};
+            const auto time = std::filesystem::last_write_time(IN_SOURCE_PATH, error);
+            if (error) return {};
+            OUT_STAMP.time = std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+            return OUT_STAMP;
+        }
+
+        static std::string name_of (const entry &IN_ENTRY) {
+            return {IN_ENTRY.name.data(), static_cast<std::size_t>(std::find(IN_ENTRY.name.begin(), IN_ENTRY.name.end(), '\0') - IN_ENTRY.name.begin())};
+        }
+
+        /**
+         * @brief FNV-1a over 64 bit words, continuing from @p IN_STATE. A trailing partial word is zero padded.
+         */
+        static std::uint64_t hash (const void *IN_DATA, const std::size_t IN_BYTES, std::uint64_t IN_STATE) noexcept {
+            const auto *bytes = static_cast<const unsigned char*>(IN_DATA);
+            for (std::size_t offset = 0; offset < IN_BYTES; offset += sizeof(std::uint64_t)) {
+                std::uint64_t word = 0;
+                std::memcpy(&word, bytes + offset, std::min(sizeof(word), IN_BYTES - offset));
+                IN_STATE = (IN_STATE ^ word) * 0x100000001b3ULL;
+            }
+            return IN_STATE;
+        }
+    };
+}
+
+#endif //CONCEPTUAL_POLAR_CACHE_H
@@ -0,0 +1,162 @@
+//
+// Created by Harshavardhan Karnati on 17/10/2026.
+//
+
+#ifndef CONCEPTUAL_POLAR_JSON_READER_H
+#define CONCEPTUAL_POLAR_JSON_READER_H
+
+#include <iostream>
+#include <istream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <stdexcept>
+
+#include "nlohmann/json.hpp"
+
+namespace concpt {
+    /**
+     * @class polar_json_reader
+     * @brief Reads the numeric array columns of a polar training JSON straight into std::vector<float>.
+     *
+     * @details The file is parsed with the nlohmann SAX interface, so no json document is built. A parsed document
+     * keeps every number as a separate json value of 16 bytes or more, four times the float it becomes, and used to be
+     * the largest copy of the training data while a polar was loaded. Keys that are not requested are skipped.
+     */
+    class polar_json_reader final : public nlohmann::json_sax<nlohmann::json> {
+    public:
+        /** @brief Requested top-level key and the vector receiving its values, nullptr to only require the key */
+        using column = std::pair<std::string, std::vector<float>*>;
+
+        /**
+         * @brief Reads the requested columns from @p IN_STREAM.
+         *
+         * @param [in] IN_STREAM JSON document with an object at the top level.
+         * @param [in] IN_COLUMNS Requested columns. All of them need to be present as arrays of numbers.
+         *
+         * @throw std::runtime_error Thrown if the document is malformed, a column is missing or is not an array of numbers.
+         */
+        static void read (std::istream &IN_STREAM, const std::vector<column> &IN_COLUMNS) {
+            polar_json_reader reader(IN_COLUMNS);
+            const bool parsed = nlohmann::json::sax_parse(IN_STREAM, &reader);
+            if (!reader.error.empty()) throw std::runtime_error(reader.error);
+            if (!parsed) throw std::runtime_error("JSON Data could not be parsed...");
+            for (std::size_t i = 0; i < IN_COLUMNS.size(); i++) {
+                if (!reader.found[i]) throw std::runtime_error("JSON Data structure is unexpected...");
+            }
+        }
+
+        bool null () override {
+            return this->scalar();
+        }
+
+        bool boolean (bool) override {
+            return this->scalar();
+        }
+
+        bool number_integer (number_integer_t IN_VALUE) override {
+            return this->number(static_cast<float>(IN_VALUE));
+        }
+
+        bool number_unsigned (number_unsigned_t IN_VALUE) override {
+            return this->number(static_cast<float>(IN_VALUE));
+        }
+
+        bool number_float (number_float_t IN_VALUE, const string_t&) override {
+            return this->number(static_cast<float>(IN_VALUE));
+        }
+
+        bool string (string_t&) override {
+            return this->scalar();
+        }
+
+        bool binary (binary_t&) override {
+            return this->scalar();
+        }
+
+        bool start_object (std::size_t) override {
+            if (this->collecting() || (this->depth == 1 && this->current != none)) return this->fail("JSON Data datatype is unknown...");
+            this->depth++;
+            return true;
+        }
+
+        bool end_object () override {
+            this->depth--;
+            return true;
+        }
+
+        bool start_array (std::size_t) override {
+            if (this->depth == 0) return this->fail("JSON Data structure is unexpected...");
+            if (this->collecting()) return this->fail("JSON Data datatype is unknown...");
+            if (this->depth == 1 && this->current != none) {
+                this->found[this->current] = true;
+                this->in_column = true;
+            }
+            this->depth++;
+            return true;
+        }
+
+        bool end_array () override {
+            this->depth--;
+            if (this->depth == 1) {
+                this->in_column = false;
+                this->current = none;
+            }
+            return true;
+        }
+
+        bool key (string_t &IN_KEY) override {
+            if (this->depth != 1) return true;
+            this->current = none;
+            for (std::size_t i = 0; i < this->columns.size(); i++) {
+                if (this->columns[i].first == IN_KEY) this->current = i;
+            }
+            return true;
+        }
+
+        bool parse_error (std::size_t IN_POSITION, const std::string&, const nlohmann::detail::exception &IN_EXCEPTION) override {
+            return this->fail(std::string(IN_EXCEPTION.what()) + " at byte " + std::to_string(IN_POSITION));
+        }
+
+    private:
+        static constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+        const std::vector<column> &columns;
+        std::vector<bool> found;
+        std::size_t current = none;
+        std::size_t depth = 0;
+        bool in_column = false;
+        std::string error;
+
+        explicit polar_json_reader (const std::vector<column> &IN_COLUMNS) : columns(IN_COLUMNS), found(IN_COLUMNS.size(), false) {}
+
+        /** @brief Inside the array of a requested key, where only numbers are accepted */
+        [[nodiscard]] bool collecting () const noexcept {
+            return this->in_column && this->depth == 2;
+        }
+
+        bool number (const float &IN_VALUE) {
+            if (this->depth == 0) return this->fail("JSON Data structure is unexpected...");
+            if (this->collecting()) {
+                if (this->columns[this->current].second != nullptr) this->columns[this->current].second->push_back(IN_VALUE);
+                return true;
+            }
+            if (this->depth == 1 && this->current != none) return this->fail("JSON Data datatype is unknown...");
+            return true;
+        }
+
+        bool scalar () {
+            if (this->depth == 0) return this->fail("JSON Data structure is unexpected...");
+            if (this->collecting() || (this->depth == 1 && this->current != none)) return this->fail("JSON Data datatype is unknown...");
+            return true;
+        }
+
+        bool fail (std::string IN_ERROR) {
+            this->error = std::move(IN_ERROR);
+            return false;
+        }
+    };
+}
+
+#endif //CONCEPTUAL_POLAR_JSON_READER_H
@@ -11,12 +11,19 @@
 
 #include <iostream>
 #include <vector>
+#include <array>
 #include <algorithm>
 #include <limits>
 #include <numeric>
 #include <concepts>
 #include <queue>
 #include <utility>
+#include <memory>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <atomic>
+#include <latch>
 
 #include "eigen3/Eigen/Core"
 #include "eigen3/Eigen/Dense"
@@ -24,6 +31,17 @@
 #include "unsupported/debug_utils.h"
 #include "unsupported/meta_checks.h"
 #include "unsupported/useful_data_types.h"
+#include "useful_datatypes/thread_pool.h"
+
+#include "storage.h"
+#include "top_k.h"
+#include "kd_tree.h"
+#include "sorted_axis.h"
+#include "prescaled_metric.h"
+#include "query_cursor.h"
+#include "training_store.h"
+#include "rectilinear_grid.h"
+#include "query_stats.h"
 
 namespace itp {
     /**
@@ -91,14 +109,42 @@ namespace itp {
  * @tparam dimension The dimensionality of the input space.
  * @tparam max_training_data_size The maximum size allocated for training data storage.
  * @tparam mean_size The size of the subset used to calculate the mean during interpolation.
+ * @tparam storage_policy Storage of the training data, itp::fixed_storage (default), itp::runtime_storage,
+ * itp::mapped_storage or itp::bfloat16_storage. Ignored with EIGEN_USE_DYNAMIC.
  *
  * @note Uses Eigen library for efficient linear algebra operations. Ensure Eigen3 is properly installed
  * and included in the project for optimal performance. By default, the code assumes the path is local.
+ * @note Thread safety: all query methods (`eval_at`, `eval_at_with_weighted_sum`, `eval_many`, `eval_at_batch`) are
+ * const and keep their scratch data on the stack, so any number of threads can query one instance, or instances
+ * sharing training data, index or grid, concurrently. Non-const methods (adding training data, building or clearing
+ * the index and grid, changing pointers or scaling factors) must not run concurrently with queries on the same data.
  */
-    template <std::size_t dimension, std::size_t max_training_data_size, std::size_t mean_size>
+    template <std::size_t dimension, std::size_t max_training_data_size, std::size_t mean_size, class storage_policy = itp::fixed_storage>
     class interpolate {
     public:
+#ifdef EIGEN_USE_DYNAMIC
+        using func_matrix_type = Eigen::Matrix<float, Eigen::Dynamic, 1>;
+        using var_matrix_type = Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
+#else
+        /** @brief Matrix type of `interpolate::func_data` */
+        using func_matrix_type = typename storage_policy::template matrix<max_training_data_size, 1>;
+
+        /** @brief Matrix type of `interpolate::var_data` */
+        using var_matrix_type = typename storage_policy::template matrix<max_training_data_size, dimension>;
+#endif
 
+        /** @brief Scalar type the training data is stored in. Queries, distances and means always use float */
+        using scalar_type = typename var_matrix_type::Scalar;
+
+        /** @brief Caller-owned state of a sequence of nearby queries, see `eval_at` with a cursor */
+        using cursor_type = itp::query_cursor<mean_size>;
+
+        /**
+         * @brief Default of `set_parallel_scan_threshold`: four partitions of `min_scan_partition_size` points, so only
+         * scans long enough to amortise queuing the helpers, such as those of the 500k point Mach polars, run in
+         * parallel.
+         */
+        static constexpr std::size_t default_parallel_scan_threshold = 131072;
 
         /**
          * @brief Default constructor for the interpolate class.
@@ -108,17 +154,153 @@ namespace itp {
             this->func_data = std::make_shared<Eigen::Matrix<float, Eigen::Dynamic, 1>>(max_training_data_size, 1);
             this->var_data = std::make_shared<Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>>(max_training_data_size, dimension);
 #else
-            this->func_data = std::make_shared<Eigen::Vector<float, max_training_data_size>>();
-            this->var_data = std::make_shared<Eigen::Matrix<float, max_training_data_size, dimension>>();
+            if constexpr (storage_policy::mapped) {
+                this->func_data = std::make_shared<func_matrix_type>(nullptr, 0);
+                this->var_data = std::make_shared<var_matrix_type>(nullptr, 0, static_cast<Eigen::Index>(dimension));
+            } else {
+                this->func_data = std::make_shared<func_matrix_type>();
+                this->var_data = std::make_shared<var_matrix_type>();
+            }
 #endif
         };
 
+#ifndef EIGEN_USE_DYNAMIC
+        /**
+         * @brief Constructs an interpolator from a training store written by `save_training_data`.
+         *
+         * @details With itp::mapped_storage the training data is used in place from a read-only mapping of the file,
+         * without a copy, and the mapping lives as long as any instance sharing the training data. Other storage
+         * policies copy the training data into their storage. Query structures (index, grid, ...) are built as usual.
+         *
+         * @param [in] IN_PATH Path of the training store.
+         *
+         * @throw std::runtime_error Thrown if the file is not a valid training store, or if its dimension differs from
+         * `dimension` or it holds more than `max_training_data_size` training points.
+         */
+        explicit interpolate (const std::filesystem::path &IN_PATH) : interpolate() {
+            this->load_training_data(std::make_shared<const itp::mapped_store>(IN_PATH));
+            this->invalidate_query_structures();
+        }
+#endif
+
 
         /**
          * @brief Virtual destructor for the interpolate class.
          */
         virtual ~interpolate () = default;
 
+#ifndef EIGEN_USE_DYNAMIC
+        /**
+         * @brief Writes the training data, `scaling_factors` and every query structure built to a training store.
+         *
+         * @details Besides the sections of `save_training_data`, the store holds the kd-tree index, the grid, the
+         * settings of the prescaled metric, the projection and the sorted points of one-dimensional instances, when
+         * they exist. `load` restores all of them without rebuilding, except the prescaled metric, whose transformed
+         * points are recomputed in a single pass. The store stays readable by the training store constructor, which
+         * ignores the extra sections. The file is replaced atomically.
+         *
+         * @param [in] IN_PATH Path of the store.
+         *
+         * @throw std::runtime_error Thrown if the file cannot be written.
+         */
+        void save (const std::filesystem::path &IN_PATH) const {
+            itp::store_writer writer(IN_PATH, dimension, this->interpolated_data_size);
+            this->write_training_data(writer);
+
+            writer.begin_section(itp::store_section::scaling_factors);
+            writer.write(this->scaling_factors.data(), dimension * sizeof(float));
+            if (this->prescaled) {
+                writer.begin_section(itp::store_section::prescaled_metric);
+                this->prescaled->write(writer);
+            }
+            if (this->projection) {
+                const std::uint64_t axis = this->projection_axis;
+                writer.begin_section(itp::store_section::projection);
+                writer.write(&axis, sizeof(axis));
+                this->projection->write(writer);
+            }
+            if (this->sorted) {
+                writer.begin_section(itp::store_section::sorted_axis);
+                this->sorted->write(writer);
+            }
+            if (this->index) {
+                writer.begin_section(itp::store_section::kd_tree);
+                this->index->write(writer);
+            }
+            if (this->grid) {
+                writer.begin_section(itp::store_section::grid);
+                this->grid->write(writer);
+            }
+            writer.finish();
+        }
+
+        /**
+         * @brief Creates an interpolator from a store written by `save`, in the state it was saved in.
+         *
+         * @details The training data is loaded as by the training store constructor, mapped in place with
+         * itp::mapped_storage. The stored query structures are validated against the training data and used as
+         * they are, so a cold start costs the file reads instead of parsing and building. Structures missing from the
+         * store, e.g. in a store written by `save_training_data`, are simply not built, except the sorted points of
+         * one-dimensional instances.
+         *
+         * @param [in] IN_PATH Path of the store.
+         *
+         * @throw std::runtime_error Thrown if the file is not a valid training store for this interpolator or a stored
+         * structure is inconsistent with the training data.
+         */
+        static interpolate load (const std::filesystem::path &IN_PATH) {
+            const auto store = std::make_shared<const itp::mapped_store>(IN_PATH);
+            interpolate OUT_MODEL;
+            OUT_MODEL.load_training_data(store);
+            const std::size_t size = OUT_MODEL.interpolated_data_size;
+
+            if (store->has_section(itp::store_section::scaling_factors)) {
+                itp::section_reader reader(store->section(itp::store_section::scaling_factors));
+                reader.read(OUT_MODEL.scaling_factors.data(), dimension);
+                reader.expect_end();
+            }
+            if (store->has_section(itp::store_section::prescaled_metric)) {
+                auto new_metric = std::make_shared<itp::prescaled_metric<dimension>>(
+                        itp::prescaled_metric<dimension>::read(store->section(itp::store_section::prescaled_metric)));
+                new_metric->build(OUT_MODEL.points(), size);
+                OUT_MODEL.prescaled = std::move(new_metric);
+            }
+            if (store->has_section(itp::store_section::projection)) {
+                itp::section_reader reader(store->section(itp::store_section::projection));
+                const auto axis = reader.read<std::uint64_t>();
+                if (axis >= dimension) throw std::runtime_error("Stored projection axis is out of range");
+                auto new_projection = std::make_shared<itp::sorted_axis>();
+                new_projection->read(reader, size);
+                reader.expect_end();
+                OUT_MODEL.projection = std::move(new_projection);
+                OUT_MODEL.projection_axis = static_cast<std::size_t>(axis);
+            }
+            if constexpr (dimension == 1) {
+                auto new_sorted = std::make_shared<itp::sorted_axis>();
+                if (store->has_section(itp::store_section::sorted_axis)) {
+                    itp::section_reader reader(store->section(itp::store_section::sorted_axis));
+                    new_sorted->read(reader, size);
+                    reader.expect_end();
+                } else {
+                    new_sorted->build(OUT_MODEL.points().col(0), size);
+                }
+                OUT_MODEL.sorted = std::move(new_sorted);
+            }
+            if (store->has_section(itp::store_section::kd_tree)) {
+                auto new_index = std::make_shared<itp::kd_tree<dimension>>();
+                new_index->read(store->section(itp::store_section::kd_tree), size);
+                OUT_MODEL.index = std::move(new_index);
+            }
+            if (store->has_section(itp::store_section::grid)) {
+                auto new_grid = std::make_shared<itp::rectilinear_grid<dimension>>();
+                new_grid->read(store->section(itp::store_section::grid));
+                OUT_MODEL.grid = std::move(new_grid);
+            }
+            return OUT_MODEL;
+        }
+#endif
+
+
 
         /**
          * @brief Adds training data to the interpolator.
@@ -160,6 +342,7 @@ namespace itp {
             this->var_data->block(this->interpolated_data_size, 0, current_training_size, dimension) = IN_VAR_DATA;
 
             this->interpolated_data_size += current_training_size;
+            this->invalidate_query_structures();
             if (this->interpolated_data_size == max_training_data_size) DEBUG_LOG("max training data size reached. No more points are accepted");
         }
 #else
@@ -175,10 +358,12 @@ namespace itp {
                 throw std::runtime_error("Input Training data size exceeds max size");
             }
 
-            this->func_data->template segment<current_training_size>(this->interpolated_data_size) = IN_FUNC_DATA;
-            this->var_data->template block<current_training_size, dimension>(this->interpolated_data_size, 0) = IN_VAR_DATA;
+            this->grow_storage(this->interpolated_data_size + current_training_size);
+            this->func_data->template segment<current_training_size>(this->interpolated_data_size) = IN_FUNC_DATA.template cast<scalar_type>();
+            this->var_data->template block<current_training_size, dimension>(this->interpolated_data_size, 0) = IN_VAR_DATA.template cast<scalar_type>();
 
             this->interpolated_data_size += current_training_size;
+            this->invalidate_query_structures();
             if (this->interpolated_data_size == max_training_data_size) DEBUG_LOG("max training data size reached. No more points are accepted");
         }
 #endif
@@ -227,6 +412,7 @@ namespace itp {
             }(std::make_index_sequence<dimension>{});
 
             this->interpolated_data_size += current_training_size;
+            this->invalidate_query_structures();
             if (this->interpolated_data_size == max_training_data_size)
                 DEBUG_LOG("max training data size reached. No more points are accepted");
         };
@@ -243,13 +429,15 @@ namespace itp {
                 throw std::runtime_error("Input Training data size exceeds max size");
             }
 
-            this->func_data->template segment<current_training_size>(this->interpolated_data_size) = IN_FUNC_DATA;
+            this->grow_storage(this->interpolated_data_size + current_training_size);
+            this->func_data->template segment<current_training_size>(this->interpolated_data_size) = IN_FUNC_DATA.template cast<scalar_type>();
 
             [&IN_VAR_DATAs..., this] <std::size_t... i> (std::index_sequence<i...>){
-                ((this->var_data->template block<current_training_size, 1>(this->interpolated_data_size, i) = IN_VAR_DATAs),...);
+                ((this->var_data->template block<current_training_size, 1>(this->interpolated_data_size, i) = IN_VAR_DATAs.template cast<scalar_type>()),...);
             }(std::make_index_sequence<dimension>{});
 
             this->interpolated_data_size += current_training_size;
+            this->invalidate_query_structures();
             if (this->interpolated_data_size == max_training_data_size)
                     DEBUG_LOG("max training data size reached. No more points are accepted");
         }
@@ -333,6 +521,228 @@ namespace itp {
         }
 #endif
 
+#ifndef EIGEN_USE_DYNAMIC
+        /**
+         * @brief Adds training data of runtime size to an interpolator with itp::runtime_storage.
+         *
+         * @details Same as the overloads above, but the number of training points is taken from the containers, so it
+         * does not need to be known at compile-time. The storage grows to exactly the new number of training points.
+         *
+         * @param [in] IN_FUNC_DATA The function values to be added, std::vector or std::array.
+         * @param [in] IN_VAR_DATAs The variable values to be added, one container per dimension.
+         *
+         * @throw std::invalid_argument Thrown if the containers are not of the same size.
+         * @throw std::runtime_error Thrown if the total size of the existing data and the new data exceeds the maximum
+         * allowed size.
+         */
+        template<class func_type, class... var_type>
+        requires (storage_policy::resizable && (sizeof...(var_type) == dimension) && (itp::check_vector_array<func_type, var_type...>))
+        void add_training_data (const func_type &IN_FUNC_DATA, const var_type&... IN_VAR_DATAs) {
+            const std::size_t current_training_size = IN_FUNC_DATA.size();
+            if (((IN_VAR_DATAs.size() != current_training_size) || ...)) {
+                std::cerr << "Required size: " << current_training_size << std::endl;
+                throw std::invalid_argument("Containers must have the same size");
+            }
+            if (this->interpolated_data_size + current_training_size > max_training_data_size) {
+                std::cerr << "Current size: " << this->interpolated_data_size
+                          << ", Attempted size: " << this->interpolated_data_size + current_training_size
+                          << ", Maximum size: " << max_training_data_size << std::endl;
+                throw std::runtime_error("Input Training data size exceeds max size");
+            }
+
+            const auto length = static_cast<Eigen::Index>(current_training_size);
+            const auto start = static_cast<Eigen::Index>(this->interpolated_data_size);
+            this->grow_storage(this->interpolated_data_size + current_training_size);
+            this->func_data->segment(start, length) = Eigen::Map<const Eigen::VectorXf>(IN_FUNC_DATA.data(), length).template cast<scalar_type>();
+
+            [&IN_VAR_DATAs..., &start, &length, this] <std::size_t... i> (std::index_sequence<i...>){
+                ((this->var_data->col(i).segment(start, length) = Eigen::Map<const Eigen::VectorXf>(IN_VAR_DATAs.data(), length).template cast<scalar_type>()),...);
+            }(std::make_index_sequence<dimension>{});
+
+            this->interpolated_data_size += current_training_size;
+            this->invalidate_query_structures();
+            if (this->interpolated_data_size == max_training_data_size)
+                DEBUG_LOG("max training data size reached. No more points are accepted");
+        }
+
+        /**
+         * @brief Reserves storage for @p IN_SIZE training points in total.
+         *
+         * @details With itp::runtime_storage the storage grows to exactly @p IN_SIZE rows at once, so the chunks of a
+         * following `append_training_data` sequence are written in place and the final storage has no slack. No effect
+         * with itp::fixed_storage, which is allocated in full on construction.
+         *
+         * @throw std::runtime_error Thrown if @p IN_SIZE exceeds `max_training_data_size`.
+         */
+        void reserve (const std::size_t &IN_SIZE) {
+            if (IN_SIZE > max_training_data_size) {
+                std::cerr << "Attempted size: " << IN_SIZE << ", Maximum size: " << max_training_data_size << std::endl;
+                throw std::runtime_error("Reserved size exceeds max size");
+            }
+            this->grow_storage(IN_SIZE);
+        }
+
+        /**
+         * @brief Appends a chunk of training data, for loading large training sets in pieces.
+         *
+         * @details The chunk is copied straight into the storage, so the caller only needs to hold one chunk at a time
+         * and the peak memory stays close to the final storage. Unlike `add_training_data`, the query structures are
+         * updated incrementally instead of dropped: the sorted points and the projection are merged, the prescaled
+         * metric is extended, and the kd-tree index keeps answering for the points it was built over while the newer
+         * points are scanned. The index is rebuilt once that unindexed tail outgrows both `index_tail_limit` and the
+         * index itself, so the index sizes double and all rebuilds together cost about two builds of the final index.
+         * Only the grid is dropped. Without `reserve`, itp::runtime_storage grows geometrically.
+         *
+         * @param [in] IN_FUNC_CHUNK The function values of the chunk, anything convertible to std::span<const float>.
+         * @param [in] IN_VAR_CHUNKS The variable values of the chunk, one per dimension.
+         *
+         * @throw std::invalid_argument Thrown if the chunks are not of the same size.
+         * @throw std::runtime_error Thrown if the total size exceeds `max_training_data_size`.
+         *
+         * @note Call `finish_training_data` after the last chunk. It also sorts the points of one-dimensional instances
+         * that had no training data before the first chunk.
+         */
+        template <class func_type, class... var_type>
+        requires (!storage_policy::mapped && (sizeof...(var_type) == dimension) &&
+                  std::is_convertible_v<const func_type&, std::span<const float>> &&
+                  (std::is_convertible_v<const var_type&, std::span<const float>> && ...))
+        void append_training_data (const func_type &IN_FUNC_CHUNK, const var_type&... IN_VAR_CHUNKS) {
+            const std::span<const float> func_chunk(IN_FUNC_CHUNK);
+            const std::array<std::span<const float>, dimension> var_chunks{std::span<const float>(IN_VAR_CHUNKS)...};
+            const std::size_t current_training_size = func_chunk.size();
+            for (const auto &chunk : var_chunks) {
+                if (chunk.size() != current_training_size) {
+                    std::cerr << "Required size: " << current_training_size << ", Given size: " << chunk.size() << std::endl;
+                    throw std::invalid_argument("Chunks must have the same size");
+                }
+            }
+            if (this->interpolated_data_size + current_training_size > max_training_data_size) {
+                std::cerr << "Current size: " << this->interpolated_data_size
+                          << ", Attempted size: " << this->interpolated_data_size + current_training_size
+                          << ", Maximum size: " << max_training_data_size << std::endl;
+                throw std::runtime_error("Input Training data size exceeds max size");
+            }
+
+            const std::size_t previous_size = this->interpolated_data_size;
+            const std::size_t required_size = previous_size + current_training_size;
+            if constexpr (storage_policy::resizable) {
+                const auto capacity = static_cast<std::size_t>(this->func_data->rows());
+                if (capacity < required_size) this->grow_storage(std::min(max_training_data_size, std::max(required_size, 2 * capacity)));
+            }
+
+            const auto start = static_cast<Eigen::Index>(previous_size);
+            const auto length = static_cast<Eigen::Index>(current_training_size);
+            this->func_data->segment(start, length) = Eigen::Map<const Eigen::VectorXf>(func_chunk.data(), length).template cast<scalar_type>();
+            for (std::size_t d = 0; d < dimension; d++) {
+                this->var_data->col(static_cast<Eigen::Index>(d)).segment(start, length) =
+                        Eigen::Map<const Eigen::VectorXf>(var_chunks[d].data(), length).template cast<scalar_type>();
+            }
+
+            this->interpolated_data_size = required_size;
+            this->extend_query_structures(previous_size);
+            if (this->interpolated_data_size == max_training_data_size)
+                DEBUG_LOG("max training data size reached. No more points are accepted");
+        }
+
+        /**
+         * @brief Appends the function values of a chunk whose training points are already in the shared training points.
+         *
+         * @details For instances linked through set_ptr_trained_data, e.g. CD sharing the points of CL: the points are
+         * appended once through `append_training_data` of one instance, and the others only write their function
+         * column here, in the same order. Link the instances before appending, so no copy of the points is made.
+         *
+         * @param [in] IN_FUNC_CHUNK The function values of the chunk, anything convertible to std::span<const float>.
+         *
+         * @throw std::runtime_error Thrown if the total size exceeds `max_training_data_size` or the shared training
+         * points hold fewer rows.
+         *
+         * @note Call `finish_training_data` after the last chunk.
+         */
+        template <class func_type>
+        requires (!storage_policy::mapped && std::is_convertible_v<const func_type&, std::span<const float>>)
+        void append_function_data (const func_type &IN_FUNC_CHUNK) {
+            const std::span<const float> func_chunk(IN_FUNC_CHUNK);
+            const std::size_t previous_size = this->interpolated_data_size;
+            const std::size_t required_size = previous_size + func_chunk.size();
+            if (required_size > max_training_data_size || required_size > static_cast<std::size_t>(this->var_data->rows())) {
+                std::cerr << "Attempted size: " << required_size << ", Training points: " << this->var_data->rows()
+                          << ", Maximum size: " << max_training_data_size << std::endl;
+                throw std::runtime_error("Function data exceeds the shared training points or the max size");
+            }
+
+            if constexpr (storage_policy::resizable) {
+                if (static_cast<std::size_t>(this->func_data->rows()) < required_size) {
+                    this->func_data->conservativeResize(this->var_data->rows());
+                }
+            }
+            const auto length = static_cast<Eigen::Index>(func_chunk.size());
+            this->func_data->segment(static_cast<Eigen::Index>(previous_size), length) =
+                    Eigen::Map<const Eigen::VectorXf>(func_chunk.data(), length).template cast<scalar_type>();
+
+            this->interpolated_data_size = required_size;
+            this->extend_query_structures(previous_size);
+        }
+
+        /**
+         * @brief Completes a sequence of `append_training_data` calls.
+         *
+         * @details Re-centres the prescaled metric and brings the kd-tree index up to date with all training points, so
+         * the queries are as fast and accurate as after `add_training_data` and a fresh `build_index`. One-dimensional
+         * instances filled only through appends get their sorted points here, unless they were shared through
+         * `set_ptr_sorted`. Storage slack of itp::runtime_storage left by appending without `reserve` is released by
+         * `shrink_to_fit`.
+         */
+        void finish_training_data () {
+            bool rebuild_index = this->index && this->index->size() != this->interpolated_data_size;
+            if (this->prescaled) {
+                auto new_metric = std::make_shared<itp::prescaled_metric<dimension>>(this->prescaled->get_axis_scales(), this->prescaled->get_log_axes());
+                new_metric->build(this->points(), this->interpolated_data_size);
+                this->prescaled = std::move(new_metric);
+                rebuild_index = static_cast<bool>(this->index);
+            }
+            if (rebuild_index) this->build_index();
+            if constexpr (dimension == 1) {
+                if (!this->sorted) {
+                    auto new_sorted = std::make_shared<itp::sorted_axis>();
+                    new_sorted->build(this->points().col(0), this->interpolated_data_size);
+                    this->sorted = std::move(new_sorted);
+                }
+            }
+        }
+
+        /**
+         * @brief Writes the training data to a versioned binary training store (see itp::store_writer).
+         *
+         * @details The store holds the function values and the training points, column-major, in native byte order.
+         * It can be loaded with the training store constructor by any interpolator of the same `dimension`, whatever
+         * its storage policy. The file is replaced atomically.
+         *
+         * @param [in] IN_PATH Path of the training store.
+         *
+         * @throw std::runtime_error Thrown if the file cannot be written.
+         */
+        void save_training_data (const std::filesystem::path &IN_PATH) const {
+            itp::store_writer writer(IN_PATH, dimension, this->interpolated_data_size);
+            this->write_training_data(writer);
+            writer.finish();
+        }
+
+        /**
+         * @brief Releases the storage beyond the added training data.
+         *
+         * @details With itp::runtime_storage, the training function values and points are resized to exactly
+         * `interpolated_data_size` rows. Storage shared through set_ptr_trained_data or set_ptr_func_data is resized for
+         * every sharing instance, so call it once all of them are trained. No effect with itp::fixed_storage.
+         */
+        void shrink_to_fit () {
+            if constexpr (storage_policy::resizable) {
+                const auto rows = static_cast<Eigen::Index>(this->interpolated_data_size);
+                if (this->func_data->rows() > rows) this->func_data->conservativeResize(rows);
+                if (this->var_data->rows() > rows) this->var_data->conservativeResize(rows, Eigen::NoChange);
+            }
+        }
+#endif
+
 
         /**
          * @brief Evaluates the function at a specified point using k-nearest points average interpolation.
@@ -354,14 +764,38 @@ namespace itp {
 #ifdef EIGEN_USE_DYNAMIC
         template <typename derived>
         requires (itp::check_eigen_dynamic<derived> && std::is_same_v<typename derived::Scalar, float>)
-        float eval_at (const Eigen::MatrixBase<derived> &IN_POINT, const bool &USE_WEIGHTS = false) {
+        float eval_at (const Eigen::MatrixBase<derived> &IN_POINT, const bool &USE_WEIGHTS = false) const {
             if (IN_POINT.rows() != dimension) throw std::runtime_error("'IN_POINT' needs to be of size 'dimension'");
+            ITP_TIME_QUERIES(this->stats, 1);
 
+            if (this->grid) return this->grid->eval(IN_POINT);
+            if (this->index || this->sorted || this->prescaled) return this->find_mean_of_neighbours(this->find_nearest(IN_POINT), USE_WEIGHTS);
             return this->find_mean_of_first_minCoeff_using_nth(IN_POINT, USE_WEIGHTS);
         }
 #else
-        float eval_at (const Eigen::Vector<float, dimension> &IN_POINT, const bool &USE_WEIGHTS = false) noexcept {
-            return this->find_mean_of_first_minCoeff_using_nth(IN_POINT, USE_WEIGHTS);    // can be replaced with find_mean_of_first_minCoeff_using_que
+        float eval_at (const Eigen::Vector<float, dimension> &IN_POINT, const bool &USE_WEIGHTS = false) const noexcept {
+            ITP_TIME_QUERIES(this->stats, 1);
+            if (this->grid) return this->grid->eval(IN_POINT);
+            return this->find_mean_of_neighbours(this->find_nearest(IN_POINT), USE_WEIGHTS);
+        }
+
+        /**
+         * @brief Evaluates the function at the next point of a sequence of nearby queries.
+         *
+         * @details The neighbours of the previous query, remembered by @p IN_CURSOR, bound the search radius of this one
+         * and the projection built by `build_projection` limits the scan to the training points within that radius
+         * along the projection axis. For coherent sequences, e.g. the radial stations of a blade in order, only a small
+         * fraction of the training points is visited. The result is the same as that of `eval_at`. Without a projection,
+         * or with a grid or the prescaled metric, this is `eval_at` and the cursor is only updated.
+         *
+         * @param [in] IN_POINT The input point to interpolate at.
+         * @param [in, out] IN_CURSOR State of the sequence, updated with the neighbours of @p IN_POINT.
+         * @param [in] USE_WEIGHTS Use inverse distance weighted mean instead of plain mean.
+         */
+        float eval_at (const Eigen::Vector<float, dimension> &IN_POINT, cursor_type &IN_CURSOR, const bool &USE_WEIGHTS = false) const noexcept {
+            ITP_TIME_QUERIES(this->stats, 1);
+            if (this->grid) return this->grid->eval(IN_POINT);
+            return this->find_mean_of_neighbours(this->find_nearest(IN_POINT, IN_CURSOR), USE_WEIGHTS);
         }
 #endif
 
@@ -387,7 +821,7 @@ namespace itp {
 #ifdef EIGEN_USE_DYNAMIC
         template <class type>
         requires (itp::check_vector_array<type>)
-        float eval_at (type&& IN_POINT, const bool &USE_WEIGHTS = false) {
+        float eval_at (type&& IN_POINT, const bool &USE_WEIGHTS = false) const {
             if (std::forward<type>(IN_POINT).size() != dimension) {
                 std::cerr << "Required size: " << dimension << ", Given size: " << std::forward<type>(IN_POINT).size() << std::endl;
                 throw std::invalid_argument("IN_POINT must have a size of 'dimension");
@@ -401,7 +835,7 @@ namespace itp {
 #else
         template <class type>
         requires (itp::check_vector_array<type>)
-        float eval_at (type&& IN_POINT, const bool &USE_WEIGHTS = false) {
+        float eval_at (type&& IN_POINT, const bool &USE_WEIGHTS = false) const {
             // checks if input size matches dimension
             if (std::forward<type>(IN_POINT).size() != dimension) {
                 std::cerr << "Required size: " << dimension << ", Given size: " << std::forward<type>(IN_POINT).size() << std::endl;
@@ -431,13 +865,13 @@ namespace itp {
 #ifdef EIGEN_USE_DYNAMIC
         template <class... types>
         requires ((sizeof...(types) == dimension) && (meta_checks::is_number_v<types> && ...))
-        float eval_at (types&&... IN_POINT) noexcept {
+        float eval_at (types&&... IN_POINT) const noexcept {
             return this->eval_at(std::vector<float>{std::forward<types>(IN_POINT)...}, false);
         }
 #else
         template <class... types>
         requires ((sizeof...(types) == dimension) && (meta_checks::is_number_v<types> && ...))
-        float eval_at (types&&... IN_POINT) noexcept {
+        float eval_at (types&&... IN_POINT) const noexcept {
             return this->eval_at(std::array<float, dimension>{std::forward<types>(IN_POINT)...}, false);
         }
 #endif
@@ -445,19 +879,125 @@ namespace itp {
 #ifdef EIGEN_USE_DYNAMIC
         template <typename... types>
         requires ((sizeof...(types) == dimension) && (meta_checks::is_number_v<types> && ...))
-        float eval_at_with_weighted_sum (types&&... IN_POINT) {
+        float eval_at_with_weighted_sum (types&&... IN_POINT) const {
             return this->eval_at(std::vector<float>{std::forward<types>(IN_POINT)...}, true);
         }
 #else
         template <class... types>
         requires ((sizeof...(types) == dimension) && (meta_checks::is_number_v<types> && ...))
-        float eval_at_with_weighted_sum (types&&... IN_POINT) {
+        float eval_at_with_weighted_sum (types&&... IN_POINT) const {
             bool keep = true;
             std::array<float, dimension> x_ = std::array<float, dimension>{std::forward<types>(IN_POINT)...};
             const float x = this->eval_at(x_, keep);
             return x;
         }
 #endif
+
+        /**
+         * @brief Evaluates this and other interpolators sharing the same training points with one neighbour search.
+         *
+         * @details Interpolators linked through set_ptr_trained_data (e.g. CL and CD of an airfoil) have the same
+         * nearest training points for any query. The `mean_size` neighbours are searched once, using the index and
+         * `scaling_factors` of this instance, and the (weighted) mean of every function is taken over them. If every
+         * interpolator uses a grid over the same axes (see `share_grid_axes`), the enclosing cell is located once and
+         * blended on every grid. If only some of them use a grid, or the grids do not share their axes, every
+         * interpolator is evaluated on its own, as with `eval_at`.
+         *
+         * @param [in] IN_POINT The input point to interpolate at.
+         * @param [in] USE_WEIGHTS Use inverse distance weighted mean instead of plain mean.
+         * @param [in] IN_OTHERS Interpolators sharing the training points of this instance.
+         *
+         * @return Interpolated values, this instance first followed by @p IN_OTHERS in order.
+         *
+         * @throw std::invalid_argument Thrown if one of @p IN_OTHERS does not share the training points of this instance.
+         */
+        template <typename derived, class... others>
+        requires (std::is_same_v<typename derived::Scalar, float> && (std::is_same_v<others, interpolate> && ...))
+        std::array<float, sizeof...(others) + 1> eval_many (const Eigen::MatrixBase<derived> &IN_POINT, const bool &USE_WEIGHTS,
+                                                            const others&... IN_OTHERS) const {
+            if (((IN_OTHERS.var_data != this->var_data || IN_OTHERS.interpolated_data_size != this->interpolated_data_size) || ...)) {
+                throw std::invalid_argument("Interpolators in 'eval_many' need to share the training points");
+            }
+            ITP_TIME_QUERIES(this->stats, 1);
+
+            if (this->grid && ((IN_OTHERS.grid && IN_OTHERS.grid->shares_axes(*this->grid)) && ...)) {
+                const auto cell = this->grid->locate(IN_POINT);
+                return {this->grid->eval(cell), IN_OTHERS.grid->eval(cell)...};
+            }
+            if (this->grid || (IN_OTHERS.grid || ...)) {
+                const auto single = [&IN_POINT, &USE_WEIGHTS] (const interpolate &IN_MODEL) -> float {
+                    if (IN_MODEL.grid) return IN_MODEL.grid->eval(IN_POINT);
+                    return IN_MODEL.find_mean_of_neighbours(IN_MODEL.find_nearest(IN_POINT), USE_WEIGHTS);
+                };
+                return {single(*this), single(IN_OTHERS)...};
+            }
+
+            const itp::top_k<mean_size> nearest = this->find_nearest(IN_POINT);
+            return {this->find_mean_of_neighbours(nearest, USE_WEIGHTS), IN_OTHERS.find_mean_of_neighbours(nearest, USE_WEIGHTS)...};
+        }
+
+        /**
+         * @brief `eval_many` for the next point of a sequence of nearby queries, see `eval_at` with a cursor.
+         *
+         * @details The cursor is shared by all interpolators, as they share the training points.
+         */
+        template <typename derived, class... others>
+        requires (std::is_same_v<typename derived::Scalar, float> && (std::is_same_v<others, interpolate> && ...))
+        std::array<float, sizeof...(others) + 1> eval_many (const Eigen::MatrixBase<derived> &IN_POINT, cursor_type &IN_CURSOR,
+                                                            const bool &USE_WEIGHTS, const others&... IN_OTHERS) const {
+            if (((IN_OTHERS.var_data != this->var_data || IN_OTHERS.interpolated_data_size != this->interpolated_data_size) || ...)) {
+                throw std::invalid_argument("Interpolators in 'eval_many' need to share the training points");
+            }
+            if (this->grid || (IN_OTHERS.grid || ...)) return this->eval_many(IN_POINT, USE_WEIGHTS, IN_OTHERS...);
+            ITP_TIME_QUERIES(this->stats, 1);
+
+            const itp::top_k<mean_size> nearest = this->find_nearest(IN_POINT, IN_CURSOR);
+            return {this->find_mean_of_neighbours(nearest, USE_WEIGHTS), IN_OTHERS.find_mean_of_neighbours(nearest, USE_WEIGHTS)...};
+        }
+
+        /**
+         * @brief Evaluates the function at many points at once.
+         *
+         * @details Same result as calling `eval_at` on every row of @p IN_POINTS, but the full scan of the default
+         * metric is amortised over tiles of `batch_tile_size` queries that share every block of training points while
+         * it is in cache. Large batches can be split across the threads of `concpt::declare::thread_pool::shared()`.
+         *
+         * @param [in] IN_POINTS Query points, one point per row, e.g. Eigen::Matrix<float, N, dimension>.
+         * @param [in] USE_WEIGHTS Use inverse distance weighted mean instead of plain mean.
+         * @param [in] IN_THREADS Number of parallel chunks, 1 evaluates on the calling thread, 0 uses one chunk per
+         * worker of the shared pool. Batches smaller than two tiles per chunk use fewer chunks.
+         *
+         * @return Interpolated values, one per row of @p IN_POINTS.
+         *
+         * @throw std::invalid_argument Thrown if @p IN_POINTS does not have `dimension` columns.
+         */
+        template <typename derived>
+        requires (std::is_same_v<typename derived::Scalar, float>)
+        std::vector<float> eval_at_batch (const Eigen::MatrixBase<derived> &IN_POINTS, const bool &USE_WEIGHTS = false,
+                                          const std::size_t &IN_THREADS = 1) const {
+            if (IN_POINTS.cols() != static_cast<Eigen::Index>(dimension)) {
+                std::cerr << "Required columns: " << dimension << ", Given columns: " << IN_POINTS.cols() << std::endl;
+                throw std::invalid_argument("IN_POINTS must have 'dimension' columns");
+            }
+
+            const auto number_of_points = static_cast<std::size_t>(IN_POINTS.rows());
+            ITP_TIME_QUERIES(this->stats, number_of_points);
+            std::vector<float> OUT_VALUES(number_of_points);
+
+            std::size_t chunks = IN_THREADS == 0 ? concpt::declare::thread_pool::shared().size() + 1 : IN_THREADS;
+            chunks = std::min(chunks, std::max<std::size_t>(number_of_points / (2 * batch_tile_size), 1));
+
+            if (chunks <= 1) {
+                this->eval_at_batch_range(IN_POINTS, USE_WEIGHTS, 0, number_of_points, OUT_VALUES.data());
+            } else {
+                concpt::declare::thread_pool::shared().parallel_for(0, number_of_points, chunks,
+                        [&IN_POINTS, &USE_WEIGHTS, &OUT_VALUES, this] (const std::size_t IN_BEGIN, const std::size_t IN_END) {
+                    this->eval_at_batch_range(IN_POINTS, USE_WEIGHTS, IN_BEGIN, IN_END, OUT_VALUES.data());
+                });
+            }
+            return OUT_VALUES;
+        }
+
         /**
          * @brief Retrieves a shared pointer to the training points data.
          *
@@ -470,10 +1010,17 @@ namespace itp {
          * @return A shared pointer to the training points data matrix of the object.
          */
 
-        auto get_ptr_trained_data () {
+        auto get_ptr_trained_data () const noexcept {
             return this->var_data;
         }
 
+        /**
+         * @return Number of training points added, the valid rows of the training points and function data.
+         */
+        [[nodiscard]] std::size_t get_training_data_size () const noexcept {
+            return this->interpolated_data_size;
+        }
+
 
         /**
          * @brief Sets the training points data pointer to a new shared pointer.
@@ -496,10 +1043,12 @@ namespace itp {
                 throw std::runtime_error("Eigen Object not compatable...");
             }
             this->var_data = IN_POINTER;
+            this->invalidate_query_structures();
         }
 #else
-        void set_ptr_trained_data (const std::shared_ptr<Eigen::Matrix<float, max_training_data_size, dimension>>& IN_POINTER) noexcept {
+        void set_ptr_trained_data (const std::shared_ptr<var_matrix_type>& IN_POINTER) {
             this->var_data = IN_POINTER;
+            this->invalidate_query_structures();
         }
 #endif
         /**
@@ -514,7 +1063,7 @@ namespace itp {
          * @return A shared pointer to the training function data matrix of the object.
          */
 
-        auto get_ptr_func_data () {
+        auto get_ptr_func_data () const noexcept {
             return this->func_data;
         }
 
@@ -543,7 +1092,7 @@ namespace itp {
             this->func_data = IN_POINTER;
         }
 #else
-        void set_ptr_func_data (const std::shared_ptr<Eigen::Matrix<float, max_training_data_size, dimension>>& IN_POINTER) noexcept {
+        void set_ptr_func_data (const std::shared_ptr<func_matrix_type>& IN_POINTER) noexcept {
             this->func_data = IN_POINTER;
         }
 #endif
@@ -564,22 +1113,456 @@ namespace itp {
         }
 #endif
 
+        /**
+         * @brief Sets the number of training points from which a single query scans them in parallel.
+         *
+         * @details Queries that scan the training points, without an index or with a long unindexed tail, split the
+         * scan across `concpt::declare::thread_pool::shared()` once at least @p IN_SIZE points are scanned. This cuts
+         * the latency of single queries on very large training sets. The result does not change. Scans stay serial
+         * when the pool has a single worker. Defaults to `default_parallel_scan_threshold`; pass
+         * std::numeric_limits<std::size_t>::max() to keep every scan serial.
+         *
+         * @note Throughput oriented callers that already query from many threads gain nothing from it and may turn it
+         * off.
+         */
+        void set_parallel_scan_threshold (const std::size_t &IN_SIZE) noexcept {
+            this->parallel_scan_threshold = IN_SIZE;
+        }
+
+        [[nodiscard]] std::size_t get_parallel_scan_threshold () const noexcept {
+            return this->parallel_scan_threshold;
+        }
+
+#ifdef USE_QUERY_INSTRUMENTATION
+        /**
+         * @brief Counters of the queries answered by this instance since construction or `reset_query_stats`.
+         *
+         * @details Only available when USE_QUERY_INSTRUMENTATION is defined. `eval_at`, `eval_many` and every point of
+         * `eval_at_batch` count as one query each; a batch splits its time equally over its points. The scanned
+         * points are the training points whose distance to a query was computed.
+         */
+        [[nodiscard]] itp::query_stats::summary get_query_stats () const noexcept {
+            return this->stats.summarise();
+        }
+
+        void reset_query_stats () noexcept {
+            this->stats.reset();
+        }
+
+        /**
+         * @brief Writes the query counters to @p OUT_STREAM on one line, see itp::query_stats::dump.
+         */
+        void dump_query_stats (std::ostream &OUT_STREAM = std::cout, const std::string_view IN_LABEL = "interpolate") const {
+            this->stats.dump(OUT_STREAM, IN_LABEL);
+        }
+#endif
+
+        /**
+         * @brief Builds a kd-tree index over the training points for O(log N) nearest points queries.
+         *
+         * @details Once built, every `eval_at` overload answers through the index instead of scanning all
+         * `interpolated_data_size` training points. The index returns the same `mean_size` neighbours as the full scan
+         * as it uses the same metric, including `scaling_factors`. Adding training data or changing the training points
+         * pointer drops the index; call this method again after the training data is final.
+         *
+         * @throw std::runtime_error Thrown if fewer than `mean_size` training points are available.
+         *
+         * @note Build after `add_major_axis_factors`. The factors only steer the splitting axes, so changing them later
+         * does not invalidate the index but might slow down the queries.
+         */
+        void build_index () {
+            if (this->interpolated_data_size < mean_size) {
+                throw std::runtime_error("Not enough training data to build the index");
+            }
+            auto new_index = std::make_shared<itp::kd_tree<dimension>>();
+            if (this->prescaled) {
+                new_index->build(this->prescaled->get_points(), this->interpolated_data_size, Eigen::Matrix<float, dimension, 1>::Ones());
+            } else {
+                new_index->build(this->points(), this->interpolated_data_size, this->scaling_factors);
+            }
+            this->index = std::move(new_index);
+        }
+
+        /**
+         * @brief Drops the kd-tree index. Later queries scan all training points.
+         */
+        void clear_index () noexcept {
+            this->index.reset();
+        }
+
+        [[nodiscard]] bool has_index () const noexcept {
+            return static_cast<bool>(this->index);
+        }
+
+        /**
+         * @brief Retrieves a shared pointer to the kd-tree index.
+         *
+         * @details Pairs with set_ptr_index to share one index between instances that share the training points
+         * through set_ptr_trained_data.
+         *
+         * @return A shared pointer to the index, nullptr if no index is built.
+         */
+        auto get_ptr_index () const noexcept {
+            return this->index;
+        }
+
+        /**
+         * @brief Sets the kd-tree index pointer to a new shared pointer.
+         *
+         * @param [in] IN_POINTER Index built over the same training points, and with the same metric mode, as this instance.
+         *
+         * @throw std::runtime_error Thrown if the index size does not match the training data size.
+         */
+        void set_ptr_index (const std::shared_ptr<itp::kd_tree<dimension>> &IN_POINTER) {
+            if (IN_POINTER && IN_POINTER->size() != this->interpolated_data_size) {
+                throw std::runtime_error("Index is not compatable with the training data...");
+            }
+            this->index = IN_POINTER;
+        }
+
+        /**
+         * @brief Retrieves a shared pointer to the sorted training points of a one-dimensional instance.
+         *
+         * @details Pairs with set_ptr_sorted to sort the points once for instances that share the training points
+         * through set_ptr_trained_data, as get_ptr_index does for the kd-tree index.
+         *
+         * @return A shared pointer to the sorted points, nullptr if they are not built.
+         */
+        auto get_ptr_sorted () const noexcept {
+            return this->sorted;
+        }
+
+        /**
+         * @brief Sets the sorted training points pointer to a new shared pointer.
+         *
+         * @param [in] IN_POINTER Sorted points of the same training points as this instance.
+         *
+         * @throw std::runtime_error Thrown if the number of sorted points does not match the training data size.
+         */
+        void set_ptr_sorted (const std::shared_ptr<itp::sorted_axis> &IN_POINTER) {
+            if (IN_POINTER && IN_POINTER->size() != this->interpolated_data_size) {
+                throw std::runtime_error("Sorted points are not compatable with the training data...");
+            }
+            this->sorted = IN_POINTER;
+        }
+
+        /**
+         * @brief Makes the grid of this instance use the axes of the grid of @p IN_OTHER if they are equal, so that
+         * `eval_many` over both locates every query once.
+         *
+         * @details Grids are replaced when they are rebuilt or baked, so call this again afterwards.
+         *
+         * @return true if both instances have grids sharing their axes afterwards.
+         */
+        bool share_grid_axes (const interpolate &IN_OTHER) {
+            if (!this->grid || !IN_OTHER.grid) return false;
+            if (this->grid->shares_axes(*IN_OTHER.grid)) return true;
+
+            // The grid may be shared with copies of this instance, which keep their own axes
+            auto new_grid = std::make_shared<itp::rectilinear_grid<dimension>>(*this->grid);
+            if (!new_grid->adopt_axes(*IN_OTHER.grid)) return false;
+            this->grid = std::move(new_grid);
+            return true;
+        }
+
+        /**
+         * @brief Switches the interpolator to multilinear interpolation if the training points form a rectilinear grid.
+         *
+         * @details The unique values of every axis are detected from the training points. If every combination of
+         * them is present exactly once, `eval_at` answers with a binary search per axis and a multilinear blend of the
+         * enclosing cell instead of the k-nearest points average. `USE_WEIGHTS` has no effect in this mode and queries
+         * outside the grid are clamped to its bounds.
+         *
+         * @return true if the grid was detected and is used for later queries, false if the training data is scattered.
+         *
+         * @note Adding training data or changing the training points pointer drops the grid.
+         */
+        bool build_grid () {
+            auto new_grid = std::make_shared<itp::rectilinear_grid<dimension>>();
+            if (!new_grid->build(this->points(), this->values(), this->interpolated_data_size)) {
+                DEBUG_LOG("Training data is not a rectilinear grid. Using k-nearest points average");
+                return false;
+            }
+            this->grid = std::move(new_grid);
+            return true;
+        }
+
+        /**
+         * @brief Switches the interpolator to multilinear interpolation over the given grid.
+         *
+         * @param [in] IN_AXES Strictly increasing node values of every axis.
+         * @param [in] IN_VALUES Function values at the grid nodes, first axis varying slowest.
+         *
+         * @throw std::invalid_argument Thrown if the axes and values are not consistent.
+         */
+        void build_grid (std::array<std::vector<float>, dimension> IN_AXES, std::vector<float> IN_VALUES) {
+            auto new_grid = std::make_shared<itp::rectilinear_grid<dimension>>();
+            new_grid->build(std::move(IN_AXES), std::move(IN_VALUES));
+            this->grid = std::move(new_grid);
+        }
+
+        /**
+         * @brief Samples the k-nearest points average onto a grid and switches the interpolator to it.
+         *
+         * @details The current k-nearest points model is evaluated at every node of @p IN_AXES and later queries are
+         * answered by multilinear interpolation of these samples, a few flops instead of a neighbour search. The error
+         * of the table is estimated by sampling the model again at the cell centres and at the midpoints of the cell
+         * edges, where a multilinear blend is furthest from its nodes. Any previous grid is dropped before sampling.
+         *
+         * @param [in] IN_AXES Strictly increasing node values of every axis, covering the region of later queries.
+         * @param [in] USE_WEIGHTS Sample the inverse distance weighted mean instead of the plain mean.
+         * @param [in] IN_THREADS Number of parallel chunks of the sampling, as in `eval_at_batch`.
+         *
+         * @return Estimated maximum absolute deviation of the table from the k-nearest points model, the largest one
+         * found over the cell centres and edge midpoints.
+         *
+         * @throw std::invalid_argument Thrown if an axis is empty or not increasing.
+         */
+        float bake_grid (std::array<std::vector<float>, dimension> IN_AXES, const bool &USE_WEIGHTS = false, const std::size_t &IN_THREADS = 0) {
+            this->grid.reset();
+
+            std::array<std::vector<float>, dimension> midpoint_axes;
+            for (std::size_t d = 0; d < dimension; d++) {
+                if (IN_AXES[d].size() == 1) {
+                    midpoint_axes[d] = IN_AXES[d];
+                    continue;
+                }
+                for (std::size_t i = 0; i + 1 < IN_AXES[d].size(); i++) {
+                    midpoint_axes[d].push_back(0.5f * (IN_AXES[d][i] + IN_AXES[d][i + 1]));
+                }
+            }
+
+            auto new_grid = std::make_shared<itp::rectilinear_grid<dimension>>();
+            new_grid->build(IN_AXES, this->eval_at_batch(tensor_points(IN_AXES), USE_WEIGHTS, IN_THREADS));
+
+            float OUT_DEVIATION = 0.0f;
+            const auto check = [&] (const std::array<std::vector<float>, dimension> &IN_SAMPLE_AXES) {
+                const auto samples = tensor_points(IN_SAMPLE_AXES);
+                const std::vector<float> reference = this->eval_at_batch(samples, USE_WEIGHTS, IN_THREADS);
+                for (Eigen::Index i = 0; i < samples.rows(); i++) {
+                    OUT_DEVIATION = std::max(OUT_DEVIATION, std::abs(new_grid->eval(samples.row(i)) - reference[i]));
+                }
+            };
+
+            // Cell centres, then the edge midpoints along every axis with more than one node
+            check(midpoint_axes);
+            for (std::size_t d = 0; d < dimension; d++) {
+                if (IN_AXES[d].size() == 1) continue;
+                std::array<std::vector<float>, dimension> edge_axes = IN_AXES;
+                edge_axes[d] = midpoint_axes[d];
+                check(edge_axes);
+            }
+
+            this->grid = std::move(new_grid);
+            return OUT_DEVIATION;
+        }
+
+        /**
+         * @brief Drops the grid. Later queries use the k-nearest points average.
+         */
+        void clear_grid () noexcept {
+            this->grid.reset();
+        }
+
+        [[nodiscard]] bool has_grid () const noexcept {
+            return static_cast<bool>(this->grid);
+        }
+
+        /**
+         * @brief Switches the k-nearest points search to a query independent metric over pre-scaled training points.
+         *
+         * @details The default metric divides every training point by the query point and `scaling_factors`, so no
+         * distance work can be done ahead of the query. In this mode every axis is instead transformed once, to
+         * (log x or x) / scale, and distances are plain euclidean distances in the transformed space (see
+         * itp::prescaled_metric). Distances to a query then take `dimension` multiply-adds per training point over
+         * precomputed norms. The neighbours, and so the results, differ from the default metric. Queries are scored
+         * one at a time, also in `eval_at_batch`: with an inner dimension of only `dimension`, a matrix product over
+         * tiles of queries measured slower than the per-query column updates.
+         *
+         * @param [in] IN_AXIS_SCALES Positive scale of every axis, in the (logarithmic) units of the axis.
+         * @param [in] IN_LOG_AXES Axes compared by their logarithm, e.g. Re.
+         *
+         * @throw std::invalid_argument Thrown if a scale is not positive.
+         *
+         * @note Drops the index, which is built in the space of the metric. The transformed points are kept up to date
+         * when training data is added.
+         */
+        void set_prescaled_metric (const std::array<float, dimension> &IN_AXIS_SCALES, const std::array<bool, dimension> &IN_LOG_AXES = {}) {
+            auto new_metric = std::make_shared<itp::prescaled_metric<dimension>>(IN_AXIS_SCALES, IN_LOG_AXES);
+            new_metric->build(this->points(), this->interpolated_data_size);
+            this->prescaled = std::move(new_metric);
+            this->index.reset();
+        }
+
+        /**
+         * @brief Returns to the default, query relative metric. Drops the index.
+         */
+        void clear_prescaled_metric () noexcept {
+            this->prescaled.reset();
+            this->index.reset();
+        }
+
+        [[nodiscard]] bool has_prescaled_metric () const noexcept {
+            return static_cast<bool>(this->prescaled);
+        }
+
+        /**
+         * @brief Sorts the training points along one axis for the cursor queries of `eval_at` and `eval_many`.
+         *
+         * @details Costs one sort and 8 bytes per training point, far less than the kd-tree index, and is kept up to date
+         * when training data is added. The axis should separate the training points well relative to the query steps,
+         * e.g. alpha for polars, which are densely sampled in alpha and coarsely in Re.
+         *
+         * @param [in] IN_AXIS Axis to sort along.
+         *
+         * @throw std::invalid_argument Thrown if @p IN_AXIS is not below `dimension`.
+         */
+        void build_projection (const std::size_t &IN_AXIS = 0) {
+            if (IN_AXIS >= dimension) throw std::invalid_argument("Projection axis needs to be below 'dimension'");
+            auto new_projection = std::make_shared<itp::sorted_axis>();
+            new_projection->build(this->points().col(static_cast<Eigen::Index>(IN_AXIS)), this->interpolated_data_size);
+            this->projection = std::move(new_projection);
+            this->projection_axis = IN_AXIS;
+        }
+
+        void clear_projection () noexcept {
+            this->projection.reset();
+        }
+
+        [[nodiscard]] bool has_projection () const noexcept {
+            return static_cast<bool>(this->projection);
+        }
+
     private:
+        /** @brief Optional multilinear interpolant, used in place of k-nearest points when the data is a grid */
+        std::shared_ptr<itp::rectilinear_grid<dimension>> grid;
+
+        /** @brief Optional spatial index over `interpolate::var_data`. nullptr means full scan */
+        std::shared_ptr<itp::kd_tree<dimension>> index;
+
+        /** @brief Sorted training points for binary search queries, kept up to date when `dimension == 1`, nullptr otherwise */
+        std::shared_ptr<itp::sorted_axis> sorted;
+
+        /** @brief Optional query independent metric, nullptr for the default metric relative to the query point */
+        std::shared_ptr<itp::prescaled_metric<dimension>> prescaled;
+
+        /** @brief Optional training points sorted along `interpolate::projection_axis`, bounds the cursor queries */
+        std::shared_ptr<itp::sorted_axis> projection;
+        std::size_t projection_axis = 0;
+
         /** @brief Tracks number of training data inputted in `interpolate::func_data` and `interpolate::var_data` */
         std::size_t interpolated_data_size = 0;
+
+        /** @brief Scans of at least this many training points run in parallel, see `interpolate::scan_blocks` */
+        std::size_t parallel_scan_threshold = default_parallel_scan_threshold;
+
+#ifdef USE_QUERY_INSTRUMENTATION
+        /** @brief Counters of the queries answered by this instance, updated by the const query methods */
+        mutable itp::query_stats stats;
+#endif
 #ifdef EIGEN_USE_DYNAMIC
         std::shared_ptr<Eigen::Matrix<float, Eigen::Dynamic, 1>> func_data;
         std::shared_ptr<Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>> var_data;
         Eigen::Matrix<float, Eigen::Dynamic, 1> scaling_factors;
 #else
         /** @brief Stores function values at the `interpolate::var_data` */
-        std::shared_ptr<Eigen::Vector<float, max_training_data_size>> func_data;
+        std::shared_ptr<func_matrix_type> func_data;
 
         /** @brief Stores training data points */
-        std::shared_ptr<Eigen::Matrix<float, max_training_data_size, dimension>> var_data;
+        std::shared_ptr<var_matrix_type> var_data;
         Eigen::Matrix<float, dimension, 1> scaling_factors;
+
+        /**
+         * @brief Makes room for @p IN_SIZE training points. Only itp::runtime_storage grows, to exactly @p IN_SIZE rows.
+         */
+        void grow_storage (const std::size_t &IN_SIZE) {
+            static_assert(!storage_policy::mapped, "Training data of itp::mapped_storage is read-only");
+            if constexpr (storage_policy::resizable) {
+                const auto rows = static_cast<Eigen::Index>(IN_SIZE);
+                if (this->func_data->rows() < rows) this->func_data->conservativeResize(rows);
+                if (this->var_data->rows() < rows) this->var_data->conservativeResize(rows, Eigen::NoChange);
+            }
+        }
+
+        /**
+         * @brief Takes the training data of @p IN_STORE, mapped in place with itp::mapped_storage and copied otherwise.
+         * Query structures are left to the caller.
+         *
+         * @throw std::runtime_error Thrown if the dimension or the size of the store do not fit this interpolator.
+         */
+        void load_training_data (const std::shared_ptr<const itp::mapped_store> &IN_STORE) {
+            if (IN_STORE->get_dimension() != dimension) {
+                std::cerr << "Required dimension: " << dimension << ", Stored dimension: " << IN_STORE->get_dimension() << std::endl;
+                throw std::runtime_error("Training store dimension does not match 'dimension'");
+            }
+            const std::size_t size = IN_STORE->get_training_data_size();
+            if (size > max_training_data_size) {
+                std::cerr << "Stored size: " << size << ", Maximum size: " << max_training_data_size << std::endl;
+                throw std::runtime_error("Training store size exceeds max size");
+            }
+
+            const auto rows = static_cast<Eigen::Index>(size);
+            const float *func = IN_STORE->floats(itp::store_section::func_data, size);
+            const float *var = IN_STORE->floats(itp::store_section::var_data, size * dimension);
+            if constexpr (storage_policy::mapped) {
+                this->func_data = std::shared_ptr<func_matrix_type>(new func_matrix_type(func, rows),
+                                                                    [IN_STORE] (func_matrix_type *IN_MAP) { delete IN_MAP; });
+                this->var_data = std::shared_ptr<var_matrix_type>(new var_matrix_type(var, rows, static_cast<Eigen::Index>(dimension)),
+                                                                  [IN_STORE] (var_matrix_type *IN_MAP) { delete IN_MAP; });
+            } else {
+                this->grow_storage(size);
+                this->func_data->head(rows) = Eigen::Map<const Eigen::VectorXf>(func, rows).template cast<scalar_type>();
+                this->var_data->topRows(rows) = Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, static_cast<int>(dimension)>>(var, rows, dimension)
+                        .template cast<scalar_type>();
+            }
+            this->interpolated_data_size = size;
+        }
+
+        /**
+         * @brief Writes the function values and the training points sections of a training store.
+         */
+        void write_training_data (itp::store_writer &OUT_WRITER) const {
+            const auto rows = static_cast<Eigen::Index>(this->interpolated_data_size);
+            const std::size_t bytes = this->interpolated_data_size * sizeof(float);
+            // stores always hold floats, compact storage is widened column by column
+            const auto write_column = [&OUT_WRITER, &rows, &bytes] (const auto &IN_COLUMN) {
+                if constexpr (std::is_same_v<scalar_type, float>) {
+                    OUT_WRITER.write(IN_COLUMN.data(), bytes);
+                } else {
+                    const Eigen::VectorXf widened = IN_COLUMN.head(rows).template cast<float>();
+                    OUT_WRITER.write(widened.data(), bytes);
+                }
+            };
+            OUT_WRITER.begin_section(itp::store_section::func_data);
+            write_column(this->func_data->col(0));
+            OUT_WRITER.begin_section(itp::store_section::var_data);
+            for (std::size_t d = 0; d < dimension; d++) write_column(this->var_data->col(static_cast<Eigen::Index>(d)));
+        }
 #endif
 
+        /**
+         * @brief Training points as float, the storage itself or a float cast of compact storage.
+         */
+        decltype(auto) points () const noexcept {
+            if constexpr (std::is_same_v<scalar_type, float>) {
+                return std::as_const(*this->var_data);
+            } else {
+                return this->var_data->template cast<float>();
+            }
+        }
+
+        /**
+         * @brief Function values as float, see `interpolate::points`.
+         */
+        decltype(auto) values () const noexcept {
+            if constexpr (std::is_same_v<scalar_type, float>) {
+                return std::as_const(*this->func_data);
+            } else {
+                return this->func_data->template cast<float>();
+            }
+        }
+
+#ifdef EIGEN_USE_DYNAMIC
         /**
          * @brief Calculate the mean of the first `mean_size` elements in `IN_FUNC` based on the minimum valued indices of
          * `IN_VALS` using `std::nth_element`
@@ -599,12 +1582,11 @@ namespace itp {
          * @note This method is marked as `noexcept` for better performance optimisations.
          * @note This version utilises a std::nth_element for efficient retrieval of minimum values from a large Eigen::Vector.
          */
-#ifdef EIGEN_USE_DYNAMIC
         template <typename derived1, typename derived2>
         requires (itp::check_eigen_dynamic<derived1> && itp::check_eigen_dynamic<derived2> &&
                   std::is_same_v<typename derived1::Scalar, float> && std::is_same_v<typename derived2::Scalar, float>)
         float find_mean_of_first_minCoeff_using_nth (const Eigen::MatrixBase<derived1> &IN_VALS, const Eigen::MatrixBase<derived2> &IN_POINT,
-                                                     const bool &USE_WEIGHTS = false) {
+                                                     const bool &USE_WEIGHTS = false) const {
             Eigen::Matrix<float, Eigen::Dynamic, 1> result = IN_POINT;
             result = (result.array() == 0).select(0.0001, result);
 
@@ -632,50 +1614,423 @@ namespace itp {
 
             return this->func_data->operator()(std::vector<std::size_t>(indices.begin(), indices.begin() + mean_size)).sum() / static_cast<float>(mean_size);
         }
+#endif
 
-#else
-        float find_mean_of_first_minCoeff_using_nth (const Eigen::Vector<float, dimension> &IN_POINT,
-                                                      const bool &USE_WEIGHTS = false) {
+        /**
+         * @brief Drops the index and grid after the training points changed. The prescaled metric is re-applied and the
+         * projection and the sorted points of one-dimensional instances are re-sorted, so they stay available.
+         */
+        void invalidate_query_structures () {
+            this->index.reset();
+            this->grid.reset();
+            if (this->prescaled) {
+                auto new_metric = std::make_shared<itp::prescaled_metric<dimension>>(this->prescaled->get_axis_scales(), this->prescaled->get_log_axes());
+                new_metric->build(this->points(), this->interpolated_data_size);
+                this->prescaled = std::move(new_metric);
+            }
+            if (this->projection) this->build_projection(this->projection_axis);
+            if constexpr (dimension == 1) {
+                auto new_sorted = std::make_shared<itp::sorted_axis>();
+                new_sorted->build(this->points().col(0), this->interpolated_data_size);
+                this->sorted = std::move(new_sorted);
+            }
+        }
+
+        /** @brief Minimum number of appended training points left out of the kd-tree index before it is rebuilt */
+        static constexpr std::size_t index_tail_limit = 4096;
+
+        /**
+         * @brief Updates the query structures after `append_training_data` added the training points from
+         * @p IN_PREVIOUS_SIZE on. Drops the grid, extends the other structures and rebuilds the index only when its
+         * unindexed tail grew too long.
+         */
+        void extend_query_structures (const std::size_t &IN_PREVIOUS_SIZE) {
+            this->grid.reset();
+            if (this->prescaled) this->prescaled->extend(this->points(), IN_PREVIOUS_SIZE, this->interpolated_data_size);
+            if (this->projection) {
+                this->projection->extend(this->points().col(static_cast<Eigen::Index>(this->projection_axis)), IN_PREVIOUS_SIZE,
+                                         this->interpolated_data_size);
+            }
+            if constexpr (dimension == 1) {
+                // Sorted points shared through set_ptr_sorted may already have been extended by another instance
+                if (this->sorted && this->sorted->size() != this->interpolated_data_size) {
+                    auto new_sorted = this->sorted.use_count() > 1 ? std::make_shared<itp::sorted_axis>(*this->sorted) : this->sorted;
+                    new_sorted->extend(this->points().col(0), IN_PREVIOUS_SIZE, this->interpolated_data_size);
+                    this->sorted = std::move(new_sorted);
+                }
+            }
+            if (this->index) {
+                const std::size_t tail = this->interpolated_data_size - this->index->size();
+                if (tail > std::max(index_tail_limit, this->index->size())) this->build_index();
+            }
+        }
+
+        /**
+         * @brief All nodes of the tensor-product grid spanned by @p IN_AXES, one per row, first axis varying slowest.
+         */
+        static Eigen::Matrix<float, Eigen::Dynamic, static_cast<int>(dimension)> tensor_points (const std::array<std::vector<float>, dimension> &IN_AXES) {
+            std::size_t number_of_points = 1;
+            for (const auto &axis : IN_AXES) number_of_points *= axis.size();
+
+            Eigen::Matrix<float, Eigen::Dynamic, static_cast<int>(dimension)> OUT_POINTS(static_cast<Eigen::Index>(number_of_points), dimension);
+            std::size_t repeat = number_of_points;
+            for (std::size_t d = 0; d < dimension; d++) {
+                if (IN_AXES[d].empty()) break;
+                repeat /= IN_AXES[d].size();
+                for (std::size_t i = 0; i < number_of_points; i++) {
+                    OUT_POINTS(static_cast<Eigen::Index>(i), static_cast<Eigen::Index>(d)) = IN_AXES[d][(i / repeat) % IN_AXES[d].size()];
+                }
+            }
+            return OUT_POINTS;
+        }
+
+        /**
+         * @brief Prepares the query point and the per-axis weights of the distance metric.
+         *
+         * @param [in] IN_POINT The input point to interpolate at, as a column or row vector of size `dimension`.
+         * @return The query point with zero values replaced by 0.0001 and the weights 1 / |point * scaling_factors|.
+         */
+        template <typename derived>
+        std::pair<Eigen::Array<float, 1, dimension>, Eigen::Array<float, 1, dimension>> metric_at (const Eigen::MatrixBase<derived> &IN_POINT) const noexcept {
+            Eigen::Array<float, 1, dimension> result = IN_POINT.reshaped().transpose().array();
+            result = (result == 0).select(0.0001f, result);
+            Eigen::Array<float, 1, dimension> weights = (result * this->scaling_factors.transpose().array()).abs().inverse();
+            return {result, weights};
+        }
+
+        /**
+         * @brief Evaluates the queries [IN_BEGIN, IN_END) of @p IN_POINTS into @p OUT_VALUES.
+         *
+         * @details Without grid, index or prescaled metric, `batch_tile_size` queries share one pass over the training
+         * points: every block of `distance_block_size` training points is loaded once and scored against all queries of
+         * the tile while it is hot in L1 cache, instead of streaming the whole training set once per query.
+         */
+        template <typename derived>
+        void eval_at_batch_range (const Eigen::MatrixBase<derived> &IN_POINTS, const bool &USE_WEIGHTS, const std::size_t IN_BEGIN,
+                                  const std::size_t IN_END, float *OUT_VALUES) const noexcept {
+            for (std::size_t tile_start = IN_BEGIN; tile_start < IN_END; tile_start += batch_tile_size) {
+                const std::size_t tile_length = std::min(batch_tile_size, IN_END - tile_start);
+
+                if (this->grid) {
+                    for (std::size_t q = tile_start; q < tile_start + tile_length; q++) OUT_VALUES[q] = this->grid->eval(IN_POINTS.row(q));
+                    continue;
+                }
+                if (this->index || this->sorted || this->prescaled) {
+                    for (std::size_t q = tile_start; q < tile_start + tile_length; q++)
+                        OUT_VALUES[q] = this->find_mean_of_neighbours(this->find_nearest(IN_POINTS.row(q)), USE_WEIGHTS);
+                    continue;
+                }
+
+                std::array<itp::top_k<mean_size>, batch_tile_size> nearest;
+                ITP_COUNT_SCANNED(this->stats, tile_length * this->interpolated_data_size);
+                std::array<Eigen::Array<float, 1, dimension>, batch_tile_size> results, weights;
+                for (std::size_t q = 0; q < tile_length; q++) std::tie(results[q], weights[q]) = this->metric_at(IN_POINTS.row(tile_start + q));
+
+                std::array<float, distance_block_size> distances;
+                for (std::size_t start = 0; start < this->interpolated_data_size; start += distance_block_size) {
+                    const std::size_t length = std::min(distance_block_size, this->interpolated_data_size - start);
+                    for (std::size_t q = 0; q < tile_length; q++) {
+                        this->scaled_distances(start, length, results[q], weights[q], distances.data());
+                        push_block(nearest[q], distances.data(), start, length);
+                    }
+                }
+                for (std::size_t q = 0; q < tile_length; q++) OUT_VALUES[tile_start + q] = this->find_mean_of_neighbours(nearest[q], USE_WEIGHTS);
+            }
+        }
+
+        /** @brief Number of queries sharing one pass over the training points in `interpolate::eval_at_batch` */
+        static constexpr std::size_t batch_tile_size = 8;
+
+        /** @brief Number of training points handled per call of `interpolate::scaled_distances`. Multiple of the AVX-512 width */
+        static constexpr std::size_t distance_block_size = 256;
+
+        /**
+         * @brief Computes the squared scaled distances of a contiguous block of training points to a query point.
+         *
+         * @details `interpolate::var_data` is column-major, so every axis of the block is a contiguous run of floats
+         * (structure of arrays). The distances are accumulated one axis at a time over the whole block, which Eigen
+         * vectorises to 8 (AVX2) or 16 (AVX-512) training points per instruction when the build enables them, e.g.
+         * `-mavx2 -mfma` or `-march=native`. With blocks of `distance_block_size` points the output stays in L1 cache
+         * between the axes and the scan runs close to memory bandwidth. With itp::bfloat16_storage every axis of the
+         * block is first widened into a float buffer of the same size, so half the bytes are read from memory.
+         *
+         * @param [in] IN_START Index of the first training point of the block.
+         * @param [in] IN_LENGTH Number of training points in the block.
+         * @param [in] IN_POINT Query point, with zero values already replaced.
+         * @param [in] IN_WEIGHTS Per-axis weights of the metric, 1 / |IN_POINT * scaling_factors|.
+         * @param [out] OUT_DISTANCES Squared distances, @p IN_LENGTH values.
+         *
+         * @note Squared distances keep the ordering of the distances used by the rest of the class.
+         */
+        void scaled_distances (const std::size_t &IN_START, const std::size_t &IN_LENGTH, const Eigen::Array<float, 1, dimension> &IN_POINT,
+                               const Eigen::Array<float, 1, dimension> &IN_WEIGHTS, float *OUT_DISTANCES) const noexcept {
+            static_assert(!std::remove_cvref_t<decltype(*this->var_data)>::IsRowMajor || dimension == 1,
+                          "Training points need to be stored column-major for the distance kernel");
+
+            Eigen::Map<Eigen::Array<float, Eigen::Dynamic, 1>> distances(OUT_DISTANCES, static_cast<Eigen::Index>(IN_LENGTH));
+            if constexpr (std::is_same_v<scalar_type, float>) {
+                distances = ((this->var_data->col(0).segment(IN_START, IN_LENGTH).array() - IN_POINT(0)) * IN_WEIGHTS(0)).square();
+                for (std::size_t d = 1; d < dimension; d++) {
+                    distances += ((this->var_data->col(d).segment(IN_START, IN_LENGTH).array() - IN_POINT(d)) * IN_WEIGHTS(d)).square();
+                }
+            } else {
+                // compact storage: every axis of the block is widened to float in L1 cache, then scored as above
+                std::array<float, distance_block_size> axis;
+                const Eigen::Map<const Eigen::Array<float, Eigen::Dynamic, 1>> widened(axis.data(), static_cast<Eigen::Index>(IN_LENGTH));
+                for (std::size_t d = 0; d < dimension; d++) {
+                    storage_policy::widen(this->var_data->col(static_cast<Eigen::Index>(d)).data() + IN_START, IN_LENGTH, axis.data());
+                    if (d == 0) {
+                        distances = ((widened - IN_POINT(0)) * IN_WEIGHTS(0)).square();
+                    } else {
+                        distances += ((widened - IN_POINT(d)) * IN_WEIGHTS(d)).square();
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Offers a block of distances from `interpolate::scaled_distances` to @p OUT_NEAREST.
+         *
+         * @details Once the selector is full almost no block holds a point closer than its k-th distance. A vectorised
+         * minimum over the block rejects those blocks without visiting every element. Blocks reaching the k-th distance
+         * exactly are still offered, as a tied point with a smaller index displaces the k-th one.
+         */
+        static void push_block (itp::top_k<mean_size> &OUT_NEAREST, const float *IN_DISTANCES, const std::size_t &IN_START,
+                                const std::size_t &IN_LENGTH) noexcept {
+            const Eigen::Map<const Eigen::Array<float, Eigen::Dynamic, 1>> distances(IN_DISTANCES, static_cast<Eigen::Index>(IN_LENGTH));
+            if (!(distances.minCoeff() <= OUT_NEAREST.worst())) return;
+            for (std::size_t i = 0; i < IN_LENGTH; i++) OUT_NEAREST.push(IN_DISTANCES[i], IN_START + i);
+        }
 
-            Eigen::Array<float, 1, dimension> result = (((IN_POINT.array() == 0).select(0.0001, IN_POINT)).transpose()).array();
+        /** @brief Upper bound of the number of partitions of a parallel scan, see `interpolate::scan_blocks` */
+        static constexpr std::size_t max_scan_partitions = 64;
 
-            auto distance_formula_with_scaling = [&result, this] (const std::size_t &i) -> float {
-                Eigen::Array<float, 1, dimension> x_ = this->var_data->row(i).array().operator-(result);
-                x_ = x_.operator/(result * this->scaling_factors.transpose().array());
-                return std::sqrt(x_.square().sum());
+        /** @brief Minimum number of training points per partition of a parallel scan */
+        static constexpr std::size_t min_scan_partition_size = 32768;
+
+        /**
+         * @brief Streams the training points from @p IN_BEGIN on through @p OUT_NEAREST, one block of
+         * `distance_block_size` points at a time.
+         *
+         * @details Scans of at least `parallel_scan_threshold` points are split into contiguous partitions when the
+         * pool has more than one worker, and each partition is scanned into its own top-`mean_size` selector. Merging
+         * the selectors gives the neighbours of the serial scan, ties included, as itp::top_k orders its pairs by
+         * distance and index. Partitions are claimed from a shared counter by the calling thread and by helper tasks
+         * queued on `concpt::declare::thread_pool::shared()`. The calling thread only waits for partitions that a
+         * helper has started, never for unrelated queued tasks, so it also works when the pool is busy or the caller is
+         * one of its workers. Helpers that start after every partition was claimed return at once. If a helper cannot
+         * be queued, the calling thread scans its partitions itself.
+         *
+         * @param [in] IN_BEGIN First training point to scan.
+         * @param [in] IN_DISTANCES Called as (start, length, distances) to write the squared distances of a block.
+         * @param [in, out] OUT_NEAREST Selector receiving the scanned points.
+         */
+        template <class distance_type>
+        void scan_blocks (const std::size_t &IN_BEGIN, const distance_type &IN_DISTANCES, itp::top_k<mean_size> &OUT_NEAREST) const noexcept {
+            const auto scan_range = [&IN_DISTANCES] (const std::size_t IN_FIRST, const std::size_t IN_LAST, itp::top_k<mean_size> &OUT_SELECTOR) {
+                std::array<float, distance_block_size> distances;
+                for (std::size_t start = IN_FIRST; start < IN_LAST; start += distance_block_size) {
+                    const std::size_t length = std::min(distance_block_size, IN_LAST - start);
+                    IN_DISTANCES(start, length, distances.data());
+                    push_block(OUT_SELECTOR, distances.data(), start, length);
+                }
             };
-            auto distance_formula = [&var_data_ = this->var_data, &result] (const std::size_t &i) -> float {
-                Eigen::Array<float, 1, dimension> x_ = var_data_->row(i).array().operator/(result) - Eigen::Array<float, 1, dimension>::Ones();
-                return std::sqrt(x_.square().sum());
+
+            const std::size_t end = this->interpolated_data_size;
+            const std::size_t length = end > IN_BEGIN ? end - IN_BEGIN : 0;
+            ITP_COUNT_SCANNED(this->stats, length);
+            if (length < this->parallel_scan_threshold) {
+                scan_range(IN_BEGIN, end, OUT_NEAREST);
+                return;
+            }
+
+            auto &pool = concpt::declare::thread_pool::shared();
+            // a single worker shares the core of the caller, so helpers would only add queuing
+            const std::size_t partitions = pool.size() > 1 ? std::min({pool.size() + 1, max_scan_partitions, length / min_scan_partition_size}) : 1;
+            if (partitions <= 1) {
+                scan_range(IN_BEGIN, end, OUT_NEAREST);
+                return;
+            }
+
+            // State shared with the helpers, which may outlive this call when they start after every partition is claimed
+            struct scan_state {
+                explicit scan_state (const std::size_t IN_PARTITIONS) : finished(static_cast<std::ptrdiff_t>(IN_PARTITIONS)) {}
+                std::atomic<std::size_t> next{0};
+                std::latch finished;
+                std::array<itp::top_k<mean_size>, max_scan_partitions> partial;
             };
-            auto compare = [&distance_formula_with_scaling] (const std::size_t &i_1, const std::size_t & i_2) -> bool {
-                return distance_formula_with_scaling(i_1) < distance_formula_with_scaling(i_2);
+            std::shared_ptr<scan_state> state;
+            try {
+                state = std::make_shared<scan_state>(partitions);
+            } catch (...) {
+                scan_range(IN_BEGIN, end, OUT_NEAREST);
+                return;
+            }
+
+            // partitions start on block boundaries, so every block is scanned exactly as in the serial scan
+            const std::size_t blocks = (length + distance_block_size - 1) / distance_block_size;
+            const auto claim_partitions = [&scan_range, state, partitions, blocks, begin = IN_BEGIN, end] () {
+                for (std::size_t p = state->next++; p < partitions; p = state->next++) {
+                    const std::size_t first = begin + p * blocks / partitions * distance_block_size;
+                    const std::size_t last = std::min(end, begin + (p + 1) * blocks / partitions * distance_block_size);
+                    scan_range(first, last, state->partial[p]);
+                    state->finished.count_down();
+                }
+            };
+
+            try {
+                for (std::size_t helper = 1; helper < partitions; helper++) pool.submit(claim_partitions);
+            } catch (...) {
+                // the calling thread claims whatever the queued helpers do not
+            }
+            claim_partitions();
+            state->finished.wait();
+            for (std::size_t p = 0; p < partitions; p++) OUT_NEAREST.merge(state->partial[p]);
+        }
+
+        /**
+         * @brief Finds the `mean_size` nearest training points to @p IN_POINT.
+         *
+         * @details With an index the kd-tree only visits the cells that can hold one of the nearest points, which makes
+         * the query O(log N). Without it, the distances are computed once per training point, in blocks, by
+         * `interpolate::scaled_distances` and streamed through a fixed-size `itp::top_k` selector, so no buffer of
+         * `interpolated_data_size` is allocated. Large scans run in parallel, see `interpolate::scan_blocks`. Points
+         * appended by `append_training_data` after the index was built are scanned the same way. One-dimensional
+         * instances answer with a binary search over `interpolate::sorted` and a window of about `mean_size` points
+         * around the query instead. As itp::top_k breaks distance ties by index, the kd-tree, the scan and the window
+         * return the same neighbours, ties included.
+         *
+         * @param [in] IN_POINT The input point to interpolate at.
+         * @return The nearest training points with their squared scaled distances.
+         */
+        template <typename derived>
+        itp::top_k<mean_size> find_nearest (const Eigen::MatrixBase<derived> &IN_POINT) const noexcept {
+            itp::top_k<mean_size> nearest;
+            if (this->prescaled) {
+                this->find_nearest_prescaled(this->prescaled->transform(IN_POINT), nearest);
+                return nearest;
+            }
+
+            const auto [result, weights] = this->metric_at(IN_POINT);
+            if constexpr (dimension == 1) {
+                if (this->sorted) {
+                    this->sorted->query(result(0), weights(0), nearest);
+                    ITP_COUNT_SCANNED(this->stats, nearest.size());
+                    return nearest;
+                }
+            }
+            std::size_t scanned = 0;
+            if (this->index) {
+                [[maybe_unused]] const std::size_t visited = this->index->query(this->points(), result, weights, nearest);
+                ITP_COUNT_SCANNED(this->stats, visited);
+                scanned = this->index->size();
+            }
+
+            this->scan_blocks(scanned, [this, &result, &weights] (const std::size_t IN_START, const std::size_t IN_LENGTH, float *OUT_DISTANCES) {
+                this->scaled_distances(IN_START, IN_LENGTH, result, weights, OUT_DISTANCES);
+            }, nearest);
+            return nearest;
+        }
+
+        /**
+         * @brief `interpolate::find_nearest` seeded by the previous query of @p IN_CURSOR and bounded by
+         * `interpolate::projection`.
+         *
+         * @details The squared distances of the seeds to the query bound the k-th nearest distance from above. The
+         * projection is scanned outwards from the query along its axis and stops once the axis distance alone exceeds
+         * the bound, which shrinks to the k-th distance found so far. Any point left out is therefore strictly further
+         * than the k nearest points, and with the (distance, index) order of itp::top_k the search is exact, ties
+         * included. Without seeds the scan still stops at the k-th distance.
+         */
+        template <typename derived>
+        itp::top_k<mean_size> find_nearest (const Eigen::MatrixBase<derived> &IN_POINT, cursor_type &IN_CURSOR) const noexcept {
+            if (!this->projection || this->prescaled) {
+                itp::top_k<mean_size> nearest = this->find_nearest(IN_POINT);
+                IN_CURSOR.remember(this->var_data.get(), nearest);
+                return nearest;
+            }
+
+            const auto [result, weights] = this->metric_at(IN_POINT);
+            const auto distance = [this, &result, &weights] (const std::size_t &IN_INDEX) -> float {
+                float OUT_DISTANCE = 0.0f;
+                for (std::size_t d = 0; d < dimension; d++) {
+                    const float scaled = (this->points()(IN_INDEX, d) - result(d)) * weights(d);
+                    OUT_DISTANCE += scaled * scaled;
+                }
+                return OUT_DISTANCE;
             };
 
-            auto que = concpt::declare::const_size_priority_deque<std::size_t>(mean_size, compare);
+            const std::size_t seeds = IN_CURSOR.size(this->var_data.get());
+            float bound = seeds == mean_size ? 0.0f : std::numeric_limits<float>::infinity();
+            for (std::size_t i = 0; i < seeds; i++) {
+                if (IN_CURSOR.seed(i) >= this->interpolated_data_size) {
+                    bound = std::numeric_limits<float>::infinity();
+                    break;
+                }
+                bound = std::max(bound, distance(IN_CURSOR.seed(i)));
+            }
 
-            for (std::size_t i = 0; i < this->interpolated_data_size; i++) {
-                que.push(i);
+            if (seeds == mean_size && bound != std::numeric_limits<float>::infinity()) {
+                ITP_COUNT_CURSOR_HIT(this->stats);
             }
 
-            const std::vector<std::size_t>& lowest_indices = que.get_container();
+            itp::top_k<mean_size> nearest;
+            [[maybe_unused]] std::size_t visited = seeds;
+            this->projection->scan(result(this->projection_axis), weights(this->projection_axis), bound,
+                                   [&nearest, &bound, &distance, &visited] (const std::size_t IN_INDEX) -> float {
+                                       visited++;
+                                       nearest.push(distance(IN_INDEX), IN_INDEX);
+                                       return std::min(bound, nearest.worst());
+                                   });
+            ITP_COUNT_SCANNED(this->stats, visited);
+            IN_CURSOR.remember(this->var_data.get(), nearest);
+            return nearest;
+        }
 
+        /**
+         * @brief Nearest training points to the transformed query @p IN_POINT under `interpolate::prescaled`.
+         */
+        void find_nearest_prescaled (const Eigen::Array<float, 1, dimension> &IN_POINT, itp::top_k<mean_size> &OUT_NEAREST) const noexcept {
+            std::size_t scanned = 0;
+            if (this->index) {
+                [[maybe_unused]] const std::size_t visited = this->index->query(this->prescaled->get_points(), IN_POINT,
+                                                                                Eigen::Array<float, 1, dimension>::Ones(), OUT_NEAREST);
+                ITP_COUNT_SCANNED(this->stats, visited);
+                scanned = this->index->size();
+            }
+
+            this->scan_blocks(scanned, [this, &IN_POINT] (const std::size_t IN_START, const std::size_t IN_LENGTH, float *OUT_DISTANCES) {
+                this->prescaled->distances(IN_START, IN_LENGTH, IN_POINT, OUT_DISTANCES);
+            }, OUT_NEAREST);
+        }
+
+        /**
+         * @brief Calculate the mean of the function values at the selected nearest training points.
+         *
+         * @param [in] IN_NEAREST Nearest training points with their squared scaled distances.
+         * @param [in] USE_WEIGHTS Weight each value with the inverse of its distance to the query point. The distances
+         * stored in @p IN_NEAREST are reused, nothing is recomputed.
+         *
+         * @return The (weighted) mean value of the function at the nearest training points.
+         */
+        float find_mean_of_neighbours (const itp::top_k<mean_size> &IN_NEAREST, const bool &USE_WEIGHTS) const noexcept {
             if (USE_WEIGHTS) {
                 float weighted_sum = 0.0f, weight = 0.0f;
-                for (std::size_t i = 0; i < mean_size; i++) {
-                    const float current_norm = distance_formula(i);
-                    if (current_norm == 0) [[unlikely]] {
-                        return this->func_data->operator()(lowest_indices[i]);
+                for (std::size_t i = 0; i < IN_NEAREST.size(); i++) {
+                    if (IN_NEAREST.distance(i) == 0) [[unlikely]] {
+                        return this->values()(IN_NEAREST.index(i));
                     }
-                    weight += (1.0f / current_norm);
-                    weighted_sum += (1.0f / current_norm) * this->func_data->operator()(lowest_indices[i]);
+                    const float current_weight = 1.0f / std::sqrt(IN_NEAREST.distance(i));
+                    weight += current_weight;
+                    weighted_sum += current_weight * this->values()(IN_NEAREST.index(i));
                 }
                 return weighted_sum / weight;
             }
 
-            return this->func_data->operator()(std::vector<std::size_t>(lowest_indices.begin(), lowest_indices.end())).sum() / static_cast<float>(mean_size);
+            float sum = 0.0f;
+            for (std::size_t i = 0; i < IN_NEAREST.size(); i++) sum += this->values()(IN_NEAREST.index(i));
+            return sum / static_cast<float>(IN_NEAREST.size());
         }
-#endif
     };
 }
 
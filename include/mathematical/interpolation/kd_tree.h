@@ -0,0 +1,262 @@
+/**
+ * @file kd_tree.h
+ * @brief Header file defining the kd_tree spatial index used by the interpolate class for k-nearest points queries.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_KD_TREE_H
+#define CONCEPTUAL_KD_TREE_H
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <span>
+#include <cstdint>
+#include <cmath>
+#include <type_traits>
+#include <stdexcept>
+
+#include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Dense"
+
+#include "top_k.h"
+#include "training_store.h"
+
+namespace itp {
+/**
+ * @class kd_tree
+ * @brief Axis-aligned kd-tree over the training points of an interpolate instance.
+ *
+ * @details The tree does not own the training points. It only stores a permutation of the row indices and the
+ * splitting planes, so it can be shared between interpolators that share their training points (see
+ * interpolate::set_ptr_trained_data). Queries take the per-axis weights of the interpolate metric,
+ * |(x - q) / (q * scaling_factors)|, which is a weighted euclidean distance for a fixed query point. Axis-aligned
+ * splitting planes bound that distance exactly, so the query returns the same neighbours as the full scan, ties
+ * included: cells whose bound equals the k-th distance are visited, and itp::top_k breaks ties by index.
+ *
+ * @tparam dimension The dimensionality of the input space.
+ */
+    template <std::size_t dimension>
+    class kd_tree {
+    public:
+        using index_type = std::uint32_t;
+
+        kd_tree () = default;
+        virtual ~kd_tree () = default;
+
+        /**
+         * @brief Builds the tree over the first @p IN_SIZE rows of @p IN_POINTS.
+         *
+         * @details The splitting axis of every node is the one with the largest spread relative to the mean magnitude
+         * of that axis and @p IN_SCALING, which is how the interpolate metric sees the data. The choice only affects
+         * query speed, not the result.
+         *
+         * @param [in] IN_POINTS Training points, one point per row.
+         * @param [in] IN_SIZE Number of valid rows in @p IN_POINTS.
+         * @param [in] IN_SCALING Major axis factors of the interpolator.
+         *
+         * @throw std::runtime_error Thrown if @p IN_SIZE does not fit in `index_type`.
+         */
+        template <typename derived1, typename derived2>
+        void build (const Eigen::MatrixBase<derived1> &IN_POINTS, const std::size_t &IN_SIZE, const Eigen::MatrixBase<derived2> &IN_SCALING) {
+            if (IN_SIZE >= static_cast<std::size_t>(std::numeric_limits<index_type>::max())) {
+                throw std::runtime_error("Training data size is too large for kd_tree index");
+            }
+            this->nodes.clear();
+            this->indices.resize(IN_SIZE);
+            std::iota(this->indices.begin(), this->indices.end(), index_type{0});
+
+            for (std::size_t d = 0; d < dimension; d++) {
+                const float mean_magnitude = IN_SIZE == 0 ? 1.0f : IN_POINTS.col(d).head(IN_SIZE).cwiseAbs().mean();
+                this->axis_normaliser(d) = 1.0f / std::max(mean_magnitude * std::abs(IN_SCALING(d)), std::numeric_limits<float>::min());
+            }
+
+            this->nodes.reserve(2 * (IN_SIZE / leaf_size + 1));
+            if (IN_SIZE != 0) this->build_node(IN_POINTS, 0, static_cast<index_type>(IN_SIZE));
+        }
+
+        /**
+         * @brief Finds the nearest training points to @p IN_QUERY.
+         *
+         * @details Pushes the squared distances of the visited training points into @p OUT_NEAREST. Cells that can not
+         * beat the current k-th distance of @p OUT_NEAREST are skipped, so a pre-filled selector prunes more.
+         *
+         * @param [in] IN_POINTS Training points the tree was built over.
+         * @param [in] IN_QUERY Query point.
+         * @param [in] IN_WEIGHTS Per-axis weights of the metric, distance = || (x - q) * weights ||.
+         * @param [in, out] OUT_NEAREST Selector collecting the nearest points.
+         *
+         * @return Number of training points visited.
+         */
+        template <typename derived, std::size_t k>
+        std::size_t query (const Eigen::MatrixBase<derived> &IN_POINTS, const Eigen::Array<float, 1, dimension> &IN_QUERY,
+                           const Eigen::Array<float, 1, dimension> &IN_WEIGHTS, itp::top_k<k> &OUT_NEAREST) const noexcept {
+            if (this->nodes.empty()) return 0;
+            return this->query_node(IN_POINTS, 0, IN_QUERY, IN_WEIGHTS, OUT_NEAREST);
+        }
+
+        /**
+         * @brief Writes the tree to the current section of @p OUT_WRITER.
+         *
+         * @details Layout: node count and index count as std::uint64_t, the `dimension` axis normalisers, the nodes as
+         * stored_node records and the row indices as index_type.
+         */
+        void write (itp::store_writer &OUT_WRITER) const {
+            const std::array<std::uint64_t, 2> counts{this->nodes.size(), this->indices.size()};
+            OUT_WRITER.write(counts.data(), sizeof(counts));
+            OUT_WRITER.write(this->axis_normaliser.data(), dimension * sizeof(float));
+
+            std::vector<stored_node> records(this->nodes.size());
+            for (std::size_t i = 0; i < this->nodes.size(); i++) {
+                const node &current = this->nodes[i];
+                records[i] = stored_node{current.begin, current.end, current.left, current.right, static_cast<std::uint32_t>(current.axis), current.split};
+            }
+            OUT_WRITER.write(records.data(), records.size() * sizeof(stored_node));
+            OUT_WRITER.write(this->indices.data(), this->indices.size() * sizeof(index_type));
+        }
+
+        /**
+         * @brief Reads a tree written by `write`.
+         *
+         * @details The tree is validated before it is used: node ranges, children and splitting axes need to be
+         * consistent, every child needs to follow its parent, as `build` lays them out, and every row index needs to
+         * be below @p IN_TRAINING_DATA_SIZE. The tree covers the first `size()` training points.
+         *
+         * @throw std::runtime_error Thrown if the payload is not a valid tree.
+         */
+        void read (const std::span<const std::byte> &IN_PAYLOAD, const std::size_t &IN_TRAINING_DATA_SIZE) {
+            itp::section_reader reader(IN_PAYLOAD);
+            const auto node_count = reader.read<std::uint64_t>();
+            const auto index_count = reader.read<std::uint64_t>();
+            if (index_count > IN_TRAINING_DATA_SIZE || (node_count == 0) != (index_count == 0)) {
+                throw std::runtime_error("Stored kd-tree does not match the training data");
+            }
+            reader.read(this->axis_normaliser.data(), dimension);
+            const std::vector<stored_node> records = reader.read_vector<stored_node>(node_count);
+            std::vector<index_type> new_indices = reader.read_vector<index_type>(index_count);
+            reader.expect_end();
+
+            std::vector<node> new_nodes(records.size());
+            for (std::size_t i = 0; i < records.size(); i++) {
+                const stored_node &record = records[i];
+                const bool leaf = record.left == no_child && record.right == no_child;
+                const auto valid_child = [&i, &records] (const index_type IN_CHILD) -> bool {
+                    return IN_CHILD > i && IN_CHILD < records.size();
+                };
+                if (record.begin > record.end || record.end > index_count || record.axis >= dimension ||
+                    (!leaf && !(valid_child(record.left) && valid_child(record.right)))) {
+                    throw std::runtime_error("Stored kd-tree node is invalid");
+                }
+                new_nodes[i] = node{record.begin, record.end, record.left, record.right, record.axis, record.split};
+            }
+            for (const index_type row : new_indices) {
+                if (row >= index_count) throw std::runtime_error("Stored kd-tree row index is out of range");
+            }
+            this->nodes = std::move(new_nodes);
+            this->indices = std::move(new_indices);
+        }
+
+        [[nodiscard]] std::size_t size () const noexcept {
+            return this->indices.size();
+        }
+
+        [[nodiscard]] bool empty () const noexcept {
+            return this->indices.empty();
+        }
+
+    private:
+        struct node {
+            index_type begin, end;
+            index_type left, right;
+            std::size_t axis;
+            float split;
+        };
+
+        /** @brief On-disk layout of a node, fixed-width and without padding */
+        struct stored_node {
+            std::uint32_t begin, end;
+            std::uint32_t left, right;
+            std::uint32_t axis;
+            float split;
+        };
+        static_assert(sizeof(stored_node) == 24 && std::is_trivially_copyable_v<stored_node>);
+
+        static constexpr index_type leaf_size = 16;
+        static constexpr index_type no_child = std::numeric_limits<index_type>::max();
+
+        std::vector<node> nodes;
+        std::vector<index_type> indices;
+        Eigen::Array<float, 1, dimension> axis_normaliser = Eigen::Array<float, 1, dimension>::Ones();
+
+        template <typename derived>
+        index_type build_node (const Eigen::MatrixBase<derived> &IN_POINTS, const index_type IN_BEGIN, const index_type IN_END) {
+            const auto current = static_cast<index_type>(this->nodes.size());
+            this->nodes.push_back(node{IN_BEGIN, IN_END, no_child, no_child, 0, 0.0f});
+            if (IN_END - IN_BEGIN <= leaf_size) return current;
+
+            std::size_t axis = 0;
+            float max_spread = -1.0f;
+            for (std::size_t d = 0; d < dimension; d++) {
+                const auto [min_it, max_it] = std::minmax_element(this->indices.begin() + IN_BEGIN, this->indices.begin() + IN_END,
+                                                                  [&IN_POINTS, d] (const index_type i, const index_type j) -> bool {
+                    return IN_POINTS(i, d) < IN_POINTS(j, d);
+                });
+                const float spread = (IN_POINTS(*max_it, d) - IN_POINTS(*min_it, d)) * this->axis_normaliser(d);
+                if (spread > max_spread) {
+                    max_spread = spread;
+                    axis = d;
+                }
+            }
+
+            const index_type middle = IN_BEGIN + (IN_END - IN_BEGIN) / 2;
+            std::nth_element(this->indices.begin() + IN_BEGIN, this->indices.begin() + middle, this->indices.begin() + IN_END,
+                             [&IN_POINTS, axis] (const index_type i, const index_type j) -> bool {
+                return IN_POINTS(i, axis) < IN_POINTS(j, axis);
+            });
+
+            const float split = IN_POINTS(this->indices[middle], axis);
+            const index_type left = this->build_node(IN_POINTS, IN_BEGIN, middle);
+            const index_type right = this->build_node(IN_POINTS, middle, IN_END);
+
+            this->nodes[current].axis = axis;
+            this->nodes[current].split = split;
+            this->nodes[current].left = left;
+            this->nodes[current].right = right;
+            return current;
+        }
+
+        template <typename derived, std::size_t k>
+        std::size_t query_node (const Eigen::MatrixBase<derived> &IN_POINTS, const index_type IN_NODE,
+                                const Eigen::Array<float, 1, dimension> &IN_QUERY, const Eigen::Array<float, 1, dimension> &IN_WEIGHTS,
+                                itp::top_k<k> &OUT_NEAREST) const noexcept {
+            const node &current = this->nodes[IN_NODE];
+
+            if (current.left == no_child) {
+                for (index_type i = current.begin; i < current.end; i++) {
+                    const std::size_t row = this->indices[i];
+                    OUT_NEAREST.push(((IN_POINTS.row(row).array() - IN_QUERY) * IN_WEIGHTS).square().sum(), row);
+                }
+                return current.end - current.begin;
+            }
+
+            const float plane_distance = (IN_QUERY(current.axis) - current.split) * IN_WEIGHTS(current.axis);
+            const index_type near = plane_distance < 0.0f ? current.left : current.right;
+            const index_type far = plane_distance < 0.0f ? current.right : current.left;
+
+            std::size_t visited = this->query_node(IN_POINTS, near, IN_QUERY, IN_WEIGHTS, OUT_NEAREST);
+            // a far cell at exactly the k-th distance can still hold a tied point with a smaller index
+            if (plane_distance * plane_distance <= OUT_NEAREST.worst()) {
+                visited += this->query_node(IN_POINTS, far, IN_QUERY, IN_WEIGHTS, OUT_NEAREST);
+            }
+            return visited;
+        }
+    };
+}
+
+#endif //CONCEPTUAL_KD_TREE_H
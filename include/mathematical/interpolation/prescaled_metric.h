@@ -0,0 +1,199 @@
+/**
+ * @file prescaled_metric.h
+ * @brief Header file defining the prescaled_metric class, a query independent distance metric for the interpolate class.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_PRESCALED_METRIC_H
+#define CONCEPTUAL_PRESCALED_METRIC_H
+
+#include <iostream>
+#include <array>
+#include <span>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <stdexcept>
+
+#include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Dense"
+
+#include "training_store.h"
+
+namespace itp {
+/**
+ * @class prescaled_metric
+ * @brief Euclidean metric over training points transformed once by fixed per-axis scales and optional logarithms.
+ *
+ * @details Every coordinate is mapped to z = (log x or x) / scale when the metric is built, and every query the same
+ * way. As the transform does not depend on the query, the squared norms of the transformed training points are
+ * precomputed and the squared distances of a block of training points Z to a query y reduce to
+ * ||z||^2 - 2 Z y^T + ||y||^2, `dimension` scaled column updates per block. Logarithmic axes suit quantities spanning decades, such as Re.
+ *
+ * @tparam dimension The dimensionality of the input space.
+ *
+ * @note Keeps a transformed copy of the training points, centred on their mean to limit the cancellation of the
+ * expanded form in single precision. Values on logarithmic axes are clamped to the smallest positive float before the
+ * logarithm.
+ */
+    template <std::size_t dimension>
+    class prescaled_metric {
+    public:
+        using points_type = Eigen::Matrix<float, Eigen::Dynamic, static_cast<int>(dimension)>;
+
+        /**
+         * @param [in] IN_AXIS_SCALES Positive scale of every axis, in the (logarithmic) units of the axis.
+         * @param [in] IN_LOG_AXES Axes compared by their logarithm.
+         *
+         * @throw std::invalid_argument Thrown if a scale is not positive.
+         */
+        prescaled_metric (const std::array<float, dimension> &IN_AXIS_SCALES, const std::array<bool, dimension> &IN_LOG_AXES)
+                : axis_scales(IN_AXIS_SCALES), log_axes(IN_LOG_AXES) {
+            for (const float scale : IN_AXIS_SCALES) {
+                if (!(scale > 0.0f)) throw std::invalid_argument("Prescaled metric axis scales need to be positive");
+            }
+        }
+
+        virtual ~prescaled_metric () = default;
+
+        /**
+         * @brief Transforms the first @p IN_SIZE rows of @p IN_POINTS and caches their squared norms.
+         */
+        template <typename derived>
+        void build (const Eigen::MatrixBase<derived> &IN_POINTS, const std::size_t &IN_SIZE) {
+            const auto rows = static_cast<Eigen::Index>(IN_SIZE);
+            this->points.resize(rows, static_cast<Eigen::Index>(dimension));
+            for (std::size_t d = 0; d < dimension; d++) {
+                if (this->log_axes[d]) {
+                    this->points.col(d) = IN_POINTS.col(d).head(rows).array().max(std::numeric_limits<float>::min()).log() / this->axis_scales[d];
+                } else {
+                    this->points.col(d) = IN_POINTS.col(d).head(rows) / this->axis_scales[d];
+                }
+            }
+            this->centre = rows == 0 ? Eigen::Array<float, 1, dimension>::Zero() : Eigen::Array<float, 1, dimension>(this->points.colwise().mean().array());
+            this->points.rowwise() -= this->centre.matrix();
+            this->norms = this->points.rowwise().squaredNorm();
+        }
+
+        /**
+         * @brief Transforms the rows [IN_PREVIOUS_SIZE, IN_SIZE) of @p IN_POINTS, which extend the points already built.
+         *
+         * @details The new points are centred on the existing centre, which is not updated. The storage grows
+         * geometrically, so a sequence of extensions costs amortised O(1) per point. Rebuild once the points are final
+         * to re-centre them.
+         */
+        template <typename derived>
+        void extend (const Eigen::MatrixBase<derived> &IN_POINTS, const std::size_t &IN_PREVIOUS_SIZE, const std::size_t &IN_SIZE) {
+            const auto start = static_cast<Eigen::Index>(IN_PREVIOUS_SIZE), length = static_cast<Eigen::Index>(IN_SIZE - IN_PREVIOUS_SIZE);
+            if (this->points.rows() < static_cast<Eigen::Index>(IN_SIZE)) {
+                const Eigen::Index capacity = std::max(static_cast<Eigen::Index>(IN_SIZE), 2 * this->points.rows());
+                this->points.conservativeResize(capacity, Eigen::NoChange);
+                this->norms.conservativeResize(capacity);
+            }
+            for (std::size_t d = 0; d < dimension; d++) {
+                auto column = this->points.col(d).segment(start, length);
+                if (this->log_axes[d]) {
+                    column = IN_POINTS.col(d).segment(start, length).array().max(std::numeric_limits<float>::min()).log() / this->axis_scales[d];
+                } else {
+                    column = IN_POINTS.col(d).segment(start, length) / this->axis_scales[d];
+                }
+                column.array() -= this->centre(d);
+            }
+            this->norms.segment(start, length) = this->points.middleRows(start, length).rowwise().squaredNorm();
+        }
+
+        /**
+         * @brief Maps a query point to the transformed, centred space.
+         */
+        template <typename derived>
+        [[nodiscard]] Eigen::Array<float, 1, dimension> transform (const Eigen::MatrixBase<derived> &IN_POINT) const noexcept {
+            Eigen::Array<float, 1, dimension> OUT_POINT = IN_POINT.reshaped().transpose().array();
+            for (std::size_t d = 0; d < dimension; d++) {
+                if (this->log_axes[d]) OUT_POINT(d) = std::log(std::max(OUT_POINT(d), std::numeric_limits<float>::min()));
+                OUT_POINT(d) /= this->axis_scales[d];
+            }
+            return OUT_POINT - this->centre;
+        }
+
+        /**
+         * @brief Squared distances of the training points [IN_START, IN_START + IN_LENGTH) to the transformed query
+         * @p IN_QUERY.
+         *
+         * @details The product Z y^T has an inner dimension of only `dimension`, so it is evaluated as `dimension` scaled
+         * column updates, vectorised over the training points, without the packing overhead of a general matrix product.
+         *
+         * @param [in] IN_QUERY Transformed query, see `transform`.
+         * @param [out] OUT_DISTANCES @p IN_LENGTH squared distances.
+         */
+        void distances (const std::size_t &IN_START, const std::size_t &IN_LENGTH, const Eigen::Array<float, 1, dimension> &IN_QUERY,
+                        float *OUT_DISTANCES) const noexcept {
+            const auto start = static_cast<Eigen::Index>(IN_START), length = static_cast<Eigen::Index>(IN_LENGTH);
+            Eigen::Map<Eigen::Array<float, Eigen::Dynamic, 1>> column(OUT_DISTANCES, length);
+            column = this->points.col(0).segment(start, length).array() * (-2.0f * IN_QUERY(0));
+            for (std::size_t d = 1; d < dimension; d++) {
+                column += this->points.col(d).segment(start, length).array() * (-2.0f * IN_QUERY(d));
+            }
+            column = (column + this->norms.segment(start, length).array() + IN_QUERY.matrix().squaredNorm()).max(0.0f);
+        }
+
+        /** @brief Transformed and centred training points, one per row. May hold unused rows beyond the training data size */
+        [[nodiscard]] const points_type& get_points () const noexcept {
+            return this->points;
+        }
+
+        /**
+         * @brief Writes the settings of the metric to the current section of @p OUT_WRITER: the `dimension` axis
+         * scales and the logarithmic axis flags as std::uint32_t. The transformed points are not written, `build`
+         * recreates them.
+         */
+        void write (itp::store_writer &OUT_WRITER) const {
+            std::array<std::uint32_t, dimension> flags{};
+            for (std::size_t d = 0; d < dimension; d++) flags[d] = this->log_axes[d] ? 1 : 0;
+            OUT_WRITER.write(this->axis_scales.data(), dimension * sizeof(float));
+            OUT_WRITER.write(flags.data(), dimension * sizeof(std::uint32_t));
+        }
+
+        /**
+         * @brief Creates an unbuilt metric from settings written by `write`.
+         *
+         * @throw std::runtime_error Thrown if the payload is not `dimension` scales and flags.
+         * @throw std::invalid_argument Thrown if a scale is not positive.
+         */
+        static prescaled_metric read (const std::span<const std::byte> &IN_PAYLOAD) {
+            itp::section_reader reader(IN_PAYLOAD);
+            std::array<float, dimension> scales{};
+            std::array<std::uint32_t, dimension> flags{};
+            reader.read(scales.data(), dimension);
+            reader.read(flags.data(), dimension);
+            reader.expect_end();
+
+            std::array<bool, dimension> log_axes{};
+            for (std::size_t d = 0; d < dimension; d++) log_axes[d] = flags[d] != 0;
+            return prescaled_metric(scales, log_axes);
+        }
+
+        [[nodiscard]] const std::array<float, dimension>& get_axis_scales () const noexcept {
+            return this->axis_scales;
+        }
+
+        [[nodiscard]] const std::array<bool, dimension>& get_log_axes () const noexcept {
+            return this->log_axes;
+        }
+
+    private:
+        std::array<float, dimension> axis_scales;
+        std::array<bool, dimension> log_axes;
+        points_type points;
+
+        /** @brief Mean of the transformed training points, subtracted from all points and queries */
+        Eigen::Array<float, 1, dimension> centre = Eigen::Array<float, 1, dimension>::Zero();
+
+        /** @brief Squared norm of every transformed training point */
+        Eigen::Matrix<float, Eigen::Dynamic, 1> norms;
+    };
+}
+
+#endif //CONCEPTUAL_PRESCALED_METRIC_H
@@ -0,0 +1,77 @@
+/**
+ * @file query_cursor.h
+ * @brief Header file defining the query_cursor class, the caller-owned state of coherent query sequences of the
+ * interpolate class.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_QUERY_CURSOR_H
+#define CONCEPTUAL_QUERY_CURSOR_H
+
+#include <iostream>
+#include <array>
+#include <cstddef>
+
+#include "top_k.h"
+
+namespace itp {
+/**
+ * @class query_cursor
+ * @brief Nearest training points of the previous query of a sequence, used to seed the search of the next one.
+ *
+ * @details Sweeps such as the radial stations of a blade query points close to each other in order. The neighbours of
+ * one query are then close to the next query too, and their distances to it bound the radius of its search. The cursor
+ * only remembers training point indices; the interpolate class recomputes their distances for every query, so a stale
+ * or foreign seed costs speed but never changes a result.
+ *
+ * @tparam k Number of neighbours remembered (the `mean_size` of the interpolate class).
+ *
+ * @note Not thread-safe. Every thread, or every independent sweep, needs its own cursor. The interpolator queried
+ * stays shared and const.
+ */
+    template <std::size_t k>
+    class query_cursor {
+    public:
+        query_cursor () = default;
+        virtual ~query_cursor () = default;
+
+        /**
+         * @brief Forgets the previous query, the next one searches without seeds.
+         */
+        void reset () noexcept {
+            this->source = nullptr;
+            this->count = 0;
+        }
+
+        /**
+         * @brief Remembers the neighbours found by @p IN_SOURCE for the current query.
+         */
+        void remember (const void *IN_SOURCE, const itp::top_k<k> &IN_NEAREST) noexcept {
+            this->source = IN_SOURCE;
+            this->count = IN_NEAREST.size();
+            for (std::size_t i = 0; i < this->count; i++) this->seeds[i] = IN_NEAREST.index(i);
+        }
+
+        /**
+         * @return Number of seeds remembered for @p IN_SOURCE, zero if the previous query went to another interpolator.
+         */
+        [[nodiscard]] std::size_t size (const void *IN_SOURCE) const noexcept {
+            return IN_SOURCE == this->source ? this->count : 0;
+        }
+
+        [[nodiscard]] std::size_t seed (const std::size_t &IN_POSITION) const noexcept {
+            return this->seeds[IN_POSITION];
+        }
+
+    private:
+        /** @brief Training data identity the seeds belong to */
+        const void *source = nullptr;
+
+        std::array<std::size_t, k> seeds{};
+        std::size_t count = 0;
+    };
+}
+
+#endif //CONCEPTUAL_QUERY_CURSOR_H
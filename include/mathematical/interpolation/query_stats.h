@@ -0,0 +1,231 @@
+/**
+ * @file query_stats.h
+ * @brief Header file defining the opt-in query counters of the interpolate class.
+ *
+ * @details The counters are compiled in only when USE_QUERY_INSTRUMENTATION is defined before the interpolation
+ * headers are included. Without it, the recording macros below expand to nothing and interpolate holds no counters.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_QUERY_STATS_H
+#define CONCEPTUAL_QUERY_STATS_H
+
+#ifdef USE_QUERY_INSTRUMENTATION
+
+#include <iostream>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+
+namespace itp {
+/**
+ * @class query_stats
+ * @brief Lock-free counters of the queries answered by one interpolator.
+ *
+ * @details Every counter is a relaxed atomic, so concurrent queries can record into the same instance. Latencies go
+ * into a log-linear histogram with four buckets per power of two of nanoseconds, so percentiles are resolved to 25 %
+ * of their value at a fixed size of 256 counters.
+ */
+    class query_stats {
+    public:
+        /**
+         * @brief Consistent-enough copy of the counters, taken with `summarise`.
+         */
+        struct summary {
+            std::uint64_t queries = 0;
+            std::uint64_t points_scanned = 0;
+
+            /** @brief Cursor queries whose seeds, the neighbours of the previous query, could be used */
+            std::uint64_t cursor_hits = 0;
+
+            std::chrono::nanoseconds total{0};
+            std::chrono::nanoseconds p50{0}, p90{0}, p99{0}, max{0};
+
+            [[nodiscard]] double points_scanned_per_query () const noexcept {
+                return this->queries == 0 ? 0.0 : static_cast<double>(this->points_scanned) / static_cast<double>(this->queries);
+            }
+
+            [[nodiscard]] std::chrono::nanoseconds mean () const noexcept {
+                return this->queries == 0 ? std::chrono::nanoseconds{0} : this->total / static_cast<std::int64_t>(this->queries);
+            }
+        };
+
+        query_stats () = default;
+        virtual ~query_stats () = default;
+
+        query_stats (const query_stats &IN_OTHER) noexcept {
+            this->copy(IN_OTHER);
+        }
+
+        query_stats& operator= (const query_stats &IN_OTHER) noexcept {
+            if (this != &IN_OTHER) this->copy(IN_OTHER);
+            return *this;
+        }
+
+        /**
+         * @brief Records @p IN_COUNT queries answered together in @p IN_ELAPSED, each with an equal share of it.
+         */
+        void add_queries (const std::uint64_t IN_COUNT, const std::chrono::nanoseconds IN_ELAPSED) noexcept {
+            if (IN_COUNT == 0) return;
+            const auto each = static_cast<std::uint64_t>(std::max<std::int64_t>(IN_ELAPSED.count(), 0)) / IN_COUNT;
+            this->queries.fetch_add(IN_COUNT, std::memory_order_relaxed);
+            this->nanoseconds.fetch_add(each * IN_COUNT, std::memory_order_relaxed);
+            this->histogram[bucket(each)].fetch_add(IN_COUNT, std::memory_order_relaxed);
+
+            std::uint64_t current = this->longest.load(std::memory_order_relaxed);
+            while (each > current && !this->longest.compare_exchange_weak(current, each, std::memory_order_relaxed)) {}
+        }
+
+        void add_scanned (const std::uint64_t IN_POINTS) noexcept {
+            this->scanned.fetch_add(IN_POINTS, std::memory_order_relaxed);
+        }
+
+        void add_cursor_hit () noexcept {
+            this->hits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] summary summarise () const noexcept {
+            summary OUT_SUMMARY;
+            OUT_SUMMARY.queries = this->queries.load(std::memory_order_relaxed);
+            OUT_SUMMARY.points_scanned = this->scanned.load(std::memory_order_relaxed);
+            OUT_SUMMARY.cursor_hits = this->hits.load(std::memory_order_relaxed);
+            OUT_SUMMARY.total = std::chrono::nanoseconds(this->nanoseconds.load(std::memory_order_relaxed));
+            OUT_SUMMARY.max = std::chrono::nanoseconds(this->longest.load(std::memory_order_relaxed));
+
+            std::array<std::uint64_t, bucket_count> counts{};
+            std::uint64_t recorded = 0;
+            for (std::size_t i = 0; i < bucket_count; i++) recorded += counts[i] = this->histogram[i].load(std::memory_order_relaxed);
+            OUT_SUMMARY.p50 = percentile(counts, recorded, 0.50);
+            OUT_SUMMARY.p90 = percentile(counts, recorded, 0.90);
+            OUT_SUMMARY.p99 = percentile(counts, recorded, 0.99);
+            // a bucket bound can exceed every latency recorded in the bucket
+            OUT_SUMMARY.p50 = std::min(OUT_SUMMARY.p50, OUT_SUMMARY.max);
+            OUT_SUMMARY.p90 = std::min(OUT_SUMMARY.p90, OUT_SUMMARY.max);
+            OUT_SUMMARY.p99 = std::min(OUT_SUMMARY.p99, OUT_SUMMARY.max);
+            return OUT_SUMMARY;
+        }
+
+        /**
+         * @brief Writes the summary to @p OUT_STREAM on one line, prefixed by @p IN_LABEL.
+         */
+        void dump (std::ostream &OUT_STREAM, const std::string_view IN_LABEL = "interpolate") const {
+            const summary current = this->summarise();
+            const auto micro = [] (const std::chrono::nanoseconds IN_TIME) -> double {
+                return static_cast<double>(IN_TIME.count()) * 1.0e-3;
+            };
+            OUT_STREAM << IN_LABEL << ": queries " << current.queries
+                       << ", total " << micro(current.total) * 1.0e-3 << " ms"
+                       << ", mean " << micro(current.mean()) << " us"
+                       << ", p50 " << micro(current.p50) << " us"
+                       << ", p90 " << micro(current.p90) << " us"
+                       << ", p99 " << micro(current.p99) << " us"
+                       << ", max " << micro(current.max) << " us"
+                       << ", scanned/query " << current.points_scanned_per_query()
+                       << ", cursor hits " << current.cursor_hits << std::endl;
+        }
+
+        void reset () noexcept {
+            this->queries.store(0, std::memory_order_relaxed);
+            this->nanoseconds.store(0, std::memory_order_relaxed);
+            this->longest.store(0, std::memory_order_relaxed);
+            this->scanned.store(0, std::memory_order_relaxed);
+            this->hits.store(0, std::memory_order_relaxed);
+            for (auto &count : this->histogram) count.store(0, std::memory_order_relaxed);
+        }
+
+    private:
+        static constexpr std::size_t bucket_count = 256;
+
+        std::atomic<std::uint64_t> queries{0};
+        std::atomic<std::uint64_t> nanoseconds{0};
+        std::atomic<std::uint64_t> longest{0};
+        std::atomic<std::uint64_t> scanned{0};
+        std::atomic<std::uint64_t> hits{0};
+        std::array<std::atomic<std::uint64_t>, bucket_count> histogram{};
+
+        /**
+         * @brief Bucket of a latency: values below 8 ns have their own bucket, larger ones are split in four buckets
+         * per power of two by their two bits below the leading one.
+         */
+        static std::size_t bucket (const std::uint64_t IN_NANOSECONDS) noexcept {
+            if (IN_NANOSECONDS < 8) return static_cast<std::size_t>(IN_NANOSECONDS);
+            const auto exponent = static_cast<std::size_t>(std::bit_width(IN_NANOSECONDS)) - 1;
+            return 4 * exponent + static_cast<std::size_t>((IN_NANOSECONDS >> (exponent - 2)) & 3);
+        }
+
+        /** @brief Exclusive upper bound of the latencies in bucket @p IN_BUCKET */
+        static std::uint64_t bucket_limit (const std::size_t IN_BUCKET) noexcept {
+            if (IN_BUCKET < 8) return IN_BUCKET + 1;
+            return (std::uint64_t{5} + IN_BUCKET % 4) << (IN_BUCKET / 4 - 2);
+        }
+
+        /** @return Upper bound of the bucket holding the @p IN_FRACTION quantile */
+        static std::chrono::nanoseconds percentile (const std::array<std::uint64_t, bucket_count> &IN_COUNTS, const std::uint64_t IN_TOTAL,
+                                                    const double IN_FRACTION) noexcept {
+            if (IN_TOTAL == 0) return std::chrono::nanoseconds{0};
+            const auto rank = static_cast<std::uint64_t>(IN_FRACTION * static_cast<double>(IN_TOTAL - 1));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; i++) {
+                seen += IN_COUNTS[i];
+                if (seen > rank) return std::chrono::nanoseconds(static_cast<std::int64_t>(bucket_limit(i)));
+            }
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(bucket_limit(bucket_count - 1)));
+        }
+
+        void copy (const query_stats &IN_OTHER) noexcept {
+            this->queries.store(IN_OTHER.queries.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            this->nanoseconds.store(IN_OTHER.nanoseconds.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            this->longest.store(IN_OTHER.longest.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            this->scanned.store(IN_OTHER.scanned.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            this->hits.store(IN_OTHER.hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            for (std::size_t i = 0; i < bucket_count; i++) {
+                this->histogram[i].store(IN_OTHER.histogram[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+    };
+
+/**
+ * @class query_timer
+ * @brief Records the queries of its scope into a query_stats on destruction.
+ */
+    class query_timer {
+    public:
+        explicit query_timer (query_stats &OUT_STATS, const std::uint64_t IN_QUERIES = 1) noexcept
+                : stats(OUT_STATS), queries(IN_QUERIES), start(std::chrono::steady_clock::now()) {}
+
+        virtual ~query_timer () {
+            this->stats.add_queries(this->queries, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->start));
+        }
+
+        query_timer (const query_timer&) = delete;
+        query_timer& operator= (const query_timer&) = delete;
+
+    private:
+        query_stats &stats;
+        std::uint64_t queries;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+/** @brief Times the queries of the enclosing scope */
+#define ITP_TIME_QUERIES(STATS, COUNT) const itp::query_timer itp_query_timer_(STATS, COUNT)
+#define ITP_COUNT_SCANNED(STATS, POINTS) (STATS).add_scanned(POINTS)
+#define ITP_COUNT_CURSOR_HIT(STATS) (STATS).add_cursor_hit()
+
+#else
+
+/** @brief Disabled statements stay statements, so `if (...) ITP_COUNT_SCANNED(...);` never has an empty body */
+#define ITP_TIME_QUERIES(STATS, COUNT) static_cast<void>(0)
+#define ITP_COUNT_SCANNED(STATS, POINTS) static_cast<void>(0)
+#define ITP_COUNT_CURSOR_HIT(STATS) static_cast<void>(0)
+
+#endif
+
+#endif //CONCEPTUAL_QUERY_STATS_H
@@ -0,0 +1,274 @@
+/**
+ * @file rectilinear_grid.h
+ * @brief Header file defining the rectilinear_grid class for multilinear interpolation over tensor-product data.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_RECTILINEAR_GRID_H
+#define CONCEPTUAL_RECTILINEAR_GRID_H
+
+#include <iostream>
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <span>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+#include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Dense"
+
+#include "training_store.h"
+
+namespace itp {
+/**
+ * @class rectilinear_grid
+ * @brief Multilinear interpolation over data sampled on a full tensor-product (rectilinear) grid.
+ *
+ * @details Airfoil polars are sampled on every (alpha, Re) or (alpha, mach, Re) combination. On such data a query
+ * only needs one binary search per axis to find the enclosing cell, and a blend of its 2^dimension corners. Queries
+ * outside the grid are clamped to the nearest face of the grid.
+ *
+ * Grids over the same axes, such as the CL and CD grids of one polar, can share one copy of the axes (`adopt_axes`).
+ * A cell found with `locate` on one of them can then be blended on every one of them.
+ *
+ * @tparam dimension The dimensionality of the input space.
+ */
+    template <std::size_t dimension>
+    class rectilinear_grid {
+    public:
+        using axes_type = std::array<std::vector<float>, dimension>;
+
+        /**
+         * @brief Enclosing cell of a query: flat index of its lowest corner and the position of the query within it.
+         */
+        struct cell {
+            std::size_t base = 0;
+            std::array<float, dimension> fraction{};
+        };
+
+        rectilinear_grid () = default;
+        virtual ~rectilinear_grid () = default;
+
+        /**
+         * @brief Detects the grid from scattered training points.
+         *
+         * @details The unique values of every column of @p IN_POINTS are taken as the grid axes. The data is accepted if
+         * every grid node is present exactly once, in any order.
+         *
+         * @param [in] IN_POINTS Training points, one point per row.
+         * @param [in] IN_FUNC Function values at @p IN_POINTS.
+         * @param [in] IN_SIZE Number of valid rows in @p IN_POINTS and @p IN_FUNC.
+         *
+         * @return true if the training points form a full rectilinear grid, false otherwise (the object is left empty).
+         */
+        template <typename derived1, typename derived2>
+        bool build (const Eigen::MatrixBase<derived1> &IN_POINTS, const Eigen::MatrixBase<derived2> &IN_FUNC, const std::size_t &IN_SIZE) {
+            this->clear();
+            if (IN_SIZE == 0) return false;
+
+            std::array<std::vector<float>, dimension> new_axes;
+            std::size_t grid_size = 1;
+            for (std::size_t d = 0; d < dimension; d++) {
+                new_axes[d].resize(IN_SIZE);
+                for (std::size_t i = 0; i < IN_SIZE; i++) new_axes[d][i] = IN_POINTS(i, d);
+                std::sort(new_axes[d].begin(), new_axes[d].end());
+                new_axes[d].erase(std::unique(new_axes[d].begin(), new_axes[d].end()), new_axes[d].end());
+                grid_size *= new_axes[d].size();
+                if (grid_size > IN_SIZE) return false;
+            }
+            if (grid_size != IN_SIZE) return false;
+
+            this->set_axes(std::move(new_axes));
+            this->values.assign(grid_size, 0.0f);
+            std::vector<bool> filled(grid_size, false);
+
+            for (std::size_t i = 0; i < IN_SIZE; i++) {
+                std::size_t flat_index = 0;
+                for (std::size_t d = 0; d < dimension; d++) {
+                    const std::vector<float> &axis = (*this->axes)[d];
+                    const auto it = std::lower_bound(axis.begin(), axis.end(), IN_POINTS(i, d));
+                    flat_index += static_cast<std::size_t>(std::distance(axis.begin(), it)) * this->strides[d];
+                }
+                if (filled[flat_index]) {
+                    this->clear();
+                    return false;
+                }
+                filled[flat_index] = true;
+                this->values[flat_index] = IN_FUNC(i);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Builds the grid from known axes and values.
+         *
+         * @param [in] IN_AXES Strictly increasing node values of every axis.
+         * @param [in] IN_VALUES Function values at the grid nodes, first axis varying slowest.
+         *
+         * @throw std::invalid_argument Thrown if an axis is empty or not increasing, or the number of values does not
+         * match the number of grid nodes.
+         */
+        void build (std::array<std::vector<float>, dimension> IN_AXES, std::vector<float> IN_VALUES) {
+            std::size_t grid_size = 1;
+            for (const auto &axis : IN_AXES) {
+                if (axis.empty() || std::adjacent_find(axis.begin(), axis.end(), std::greater_equal<>()) != axis.end()) {
+                    throw std::invalid_argument("Grid axes need to be non-empty and strictly increasing");
+                }
+                grid_size *= axis.size();
+            }
+            if (grid_size != IN_VALUES.size()) {
+                std::cerr << "Grid nodes: " << grid_size << ", Given values: " << IN_VALUES.size() << std::endl;
+                throw std::invalid_argument("Number of values needs to match the number of grid nodes");
+            }
+            this->set_axes(std::move(IN_AXES));
+            this->values = std::move(IN_VALUES);
+        }
+
+        /**
+         * @brief Evaluates the multilinear interpolant at @p IN_POINT.
+         *
+         * @param [in] IN_POINT Query point, clamped to the grid bounds.
+         * @return Interpolated value at the query point.
+         */
+        template <typename derived>
+        [[nodiscard]] float eval (const Eigen::DenseBase<derived> &IN_POINT) const noexcept {
+            return this->eval(this->locate(IN_POINT));
+        }
+
+        /**
+         * @brief Finds the cell enclosing @p IN_POINT, clamped to the grid bounds, with one binary search per axis.
+         */
+        template <typename derived>
+        [[nodiscard]] cell locate (const Eigen::DenseBase<derived> &IN_POINT) const noexcept {
+            cell OUT_CELL;
+            for (std::size_t d = 0; d < dimension; d++) {
+                const std::vector<float> &axis = (*this->axes)[d];
+                if (axis.size() == 1) continue;
+
+                const float x = std::clamp(static_cast<float>(IN_POINT(d)), axis.front(), axis.back());
+                const auto it = std::upper_bound(axis.begin() + 1, axis.end() - 1, x);
+                const auto lower = static_cast<std::size_t>(std::distance(axis.begin(), it)) - 1;
+                OUT_CELL.fraction[d] = (x - axis[lower]) / (axis[lower + 1] - axis[lower]);
+                OUT_CELL.base += lower * this->strides[d];
+            }
+            return OUT_CELL;
+        }
+
+        /**
+         * @brief Blends the corners of @p IN_CELL, found by `locate` on this grid or on one sharing its axes.
+         */
+        [[nodiscard]] float eval (const cell &IN_CELL) const noexcept {
+            float OUT_VALUE = 0.0f;
+            for (std::size_t corner = 0; corner < (std::size_t{1} << dimension); corner++) {
+                float weight = 1.0f;
+                std::size_t offset = IN_CELL.base;
+                for (std::size_t d = 0; d < dimension; d++) {
+                    if (corner & (std::size_t{1} << d)) {
+                        if ((*this->axes)[d].size() == 1) {
+                            weight = 0.0f;
+                            break;
+                        }
+                        weight *= IN_CELL.fraction[d];
+                        offset += this->strides[d];
+                    } else {
+                        weight *= 1.0f - IN_CELL.fraction[d];
+                    }
+                }
+                if (weight != 0.0f) OUT_VALUE += weight * this->values[offset];
+            }
+            return OUT_VALUE;
+        }
+
+        /**
+         * @brief Makes this grid use the axes of @p IN_OTHER if they are equal to its own.
+         *
+         * @return true if both grids share their axes afterwards.
+         */
+        bool adopt_axes (const rectilinear_grid &IN_OTHER) {
+            if (this->axes != IN_OTHER.axes && *this->axes != *IN_OTHER.axes) return false;
+            this->axes = IN_OTHER.axes;
+            return true;
+        }
+
+        /**
+         * @return true if cells located on @p IN_OTHER can be evaluated on this grid. Constant time.
+         */
+        [[nodiscard]] bool shares_axes (const rectilinear_grid &IN_OTHER) const noexcept {
+            return this->axes == IN_OTHER.axes;
+        }
+
+        [[nodiscard]] const axes_type& get_axes () const noexcept {
+            return *this->axes;
+        }
+
+        [[nodiscard]] const std::vector<float>& get_values () const noexcept {
+            return this->values;
+        }
+
+        /**
+         * @brief Writes the grid to the current section of @p OUT_WRITER: for every axis its node count as
+         * std::uint64_t and its nodes, then the count and the values.
+         */
+        void write (itp::store_writer &OUT_WRITER) const {
+            const auto write_floats = [&OUT_WRITER] (const std::vector<float> &IN_VALUES) {
+                const std::uint64_t count = IN_VALUES.size();
+                OUT_WRITER.write(&count, sizeof(count));
+                OUT_WRITER.write(IN_VALUES.data(), IN_VALUES.size() * sizeof(float));
+            };
+            for (const auto &axis : *this->axes) write_floats(axis);
+            write_floats(this->values);
+        }
+
+        /**
+         * @brief Reads a grid written by `write`.
+         *
+         * @throw std::runtime_error Thrown if the payload is truncated.
+         * @throw std::invalid_argument Thrown if the axes or the values are inconsistent, as in `build`.
+         */
+        void read (const std::span<const std::byte> &IN_PAYLOAD) {
+            itp::section_reader reader(IN_PAYLOAD);
+            std::array<std::vector<float>, dimension> new_axes;
+            for (auto &axis : new_axes) axis = reader.read_vector<float>(reader.read<std::uint64_t>());
+            std::vector<float> new_values = reader.read_vector<float>(reader.read<std::uint64_t>());
+            reader.expect_end();
+            this->build(std::move(new_axes), std::move(new_values));
+        }
+
+        [[nodiscard]] bool empty () const noexcept {
+            return this->values.empty();
+        }
+
+        void clear () {
+            this->axes = std::make_shared<const axes_type>();
+            this->values.clear();
+        }
+
+    private:
+        /** @brief Node values of every axis, strictly increasing. Shared with the grids that adopted them, never modified */
+        std::shared_ptr<const axes_type> axes = std::make_shared<const axes_type>();
+
+        /** @brief Flat index step of every axis, last axis is contiguous */
+        std::array<std::size_t, dimension> strides{};
+
+        /** @brief Function values at the grid nodes */
+        std::vector<float> values;
+
+        void set_axes (axes_type &&IN_AXES) {
+            this->axes = std::make_shared<const axes_type>(std::move(IN_AXES));
+            std::size_t stride = 1;
+            for (std::size_t d = dimension; d-- > 0;) {
+                this->strides[d] = stride;
+                stride *= (*this->axes)[d].size();
+            }
+        }
+    };
+}
+
+#endif //CONCEPTUAL_RECTILINEAR_GRID_H
@@ -0,0 +1,213 @@
+/**
+ * @file sorted_axis.h
+ * @brief Header file defining the sorted_axis index used by one-dimensional interpolate instances.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_SORTED_AXIS_H
+#define CONCEPTUAL_SORTED_AXIS_H
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <iterator>
+#include <array>
+#include <span>
+#include <limits>
+#include <cstdint>
+#include <stdexcept>
+
+#include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Dense"
+
+#include "top_k.h"
+#include "training_store.h"
+
+namespace itp {
+/**
+ * @class sorted_axis
+ * @brief Sorted copy of one-dimensional training points for k-nearest points queries by binary search.
+ *
+ * @details In one dimension the interpolate metric |(x - q) / (q * scaling_factor)| is the plain distance |x - q| times
+ * a constant of the query, so the k nearest points are a contiguous window of the sorted values around the query. A
+ * binary search finds the window start and a two-sided merge fills it. The merge continues past k points while they
+ * tie with the k-th distance, so equidistant points are chosen by index, as in the full scan, not by position. The
+ * training points themselves are left in place; only the sorted values and their original row indices are stored.
+ *
+ * Built over one axis of a multi-dimensional data set, it serves as the projection that bounds the query cursor
+ * searches of the interpolate class.
+ */
+    class sorted_axis {
+    public:
+        using index_type = std::uint32_t;
+
+        sorted_axis () = default;
+        virtual ~sorted_axis () = default;
+
+        /**
+         * @brief Sorts the first @p IN_SIZE values of @p IN_POINTS.
+         *
+         * @throw std::runtime_error Thrown if @p IN_SIZE does not fit in `index_type`.
+         */
+        template <typename derived>
+        void build (const Eigen::MatrixBase<derived> &IN_POINTS, const std::size_t &IN_SIZE) {
+            if (IN_SIZE >= static_cast<std::size_t>(std::numeric_limits<index_type>::max())) {
+                throw std::runtime_error("Training data size is too large for sorted_axis index");
+            }
+            this->order.resize(IN_SIZE);
+            std::iota(this->order.begin(), this->order.end(), index_type{0});
+            std::stable_sort(this->order.begin(), this->order.end(), [&IN_POINTS] (const index_type i, const index_type j) -> bool {
+                return IN_POINTS(i) < IN_POINTS(j);
+            });
+
+            this->keys.resize(IN_SIZE);
+            for (std::size_t i = 0; i < IN_SIZE; i++) this->keys[i] = IN_POINTS(this->order[i]);
+        }
+
+        /**
+         * @brief Adds the values [IN_PREVIOUS_SIZE, IN_SIZE) of @p IN_POINTS to the values already sorted.
+         *
+         * @details The new values are sorted on their own and merged in from the back, so an extension costs
+         * O(m log m + n) for m new and n sorted values instead of a full sort.
+         *
+         * @throw std::runtime_error Thrown if @p IN_SIZE does not fit in `index_type`.
+         */
+        template <typename derived>
+        void extend (const Eigen::MatrixBase<derived> &IN_POINTS, const std::size_t &IN_PREVIOUS_SIZE, const std::size_t &IN_SIZE) {
+            if (IN_PREVIOUS_SIZE != this->keys.size()) {
+                this->build(IN_POINTS, IN_SIZE);
+                return;
+            }
+            if (IN_SIZE >= static_cast<std::size_t>(std::numeric_limits<index_type>::max())) {
+                throw std::runtime_error("Training data size is too large for sorted_axis index");
+            }
+
+            std::vector<index_type> added(IN_SIZE - IN_PREVIOUS_SIZE);
+            std::iota(added.begin(), added.end(), static_cast<index_type>(IN_PREVIOUS_SIZE));
+            std::stable_sort(added.begin(), added.end(), [&IN_POINTS] (const index_type i, const index_type j) -> bool {
+                return IN_POINTS(i) < IN_POINTS(j);
+            });
+
+            this->keys.resize(IN_SIZE);
+            this->order.resize(IN_SIZE);
+            // ties keep the older point first, as the full stable sort would
+            for (std::size_t old = IN_PREVIOUS_SIZE, remaining = added.size(), out = IN_SIZE; remaining > 0;) {
+                const float key = IN_POINTS(added[remaining - 1]);
+                out--;
+                if (old > 0 && this->keys[old - 1] > key) {
+                    this->keys[out] = this->keys[old - 1];
+                    this->order[out] = this->order[old - 1];
+                    old--;
+                } else {
+                    this->keys[out] = key;
+                    this->order[out] = added[remaining - 1];
+                    remaining--;
+                }
+            }
+        }
+
+        /**
+         * @brief Finds the nearest training points to @p IN_QUERY.
+         *
+         * @param [in] IN_QUERY Query value.
+         * @param [in] IN_WEIGHT Weight of the metric, distance = |x - q| * weight.
+         * @param [in, out] OUT_NEAREST Selector receiving the k nearest points with their squared distances.
+         */
+        template <std::size_t k>
+        void query (const float &IN_QUERY, const float &IN_WEIGHT, itp::top_k<k> &OUT_NEAREST) const noexcept {
+            const std::size_t n = this->keys.size();
+            std::size_t right = static_cast<std::size_t>(std::distance(this->keys.begin(),
+                                                                       std::lower_bound(this->keys.begin(), this->keys.end(), IN_QUERY)));
+            std::size_t left = right;
+
+            while (left > 0 || right < n) {
+                const bool take_right = left == 0 || (right < n && this->keys[right] - IN_QUERY < IN_QUERY - this->keys[left - 1]);
+                const std::size_t position = take_right ? right++ : --left;
+                const float distance = (this->keys[position] - IN_QUERY) * IN_WEIGHT;
+                // distances never decrease along the merge, so past the k-th distance no point can enter
+                if (distance * distance > OUT_NEAREST.worst()) return;
+                OUT_NEAREST.push(distance * distance, this->order[position]);
+            }
+        }
+
+        /**
+         * @brief Visits the training points in increasing distance along the axis from @p IN_QUERY until that distance
+         * exceeds a bound.
+         *
+         * @details The distance along one axis is a lower bound of the full distance of a point, so every point left
+         * unvisited is further than the bound. Points whose axis distance equals the bound are still visited, as they
+         * can tie with the k-th nearest point.
+         *
+         * @param [in] IN_QUERY Query value on the axis.
+         * @param [in] IN_WEIGHT Weight of the axis in the metric.
+         * @param [in] IN_BOUND Initial squared distance bound, infinity to allow visiting every point.
+         * @param [in] IN_VISIT Called with the row index of every visited point, returns the new squared distance bound.
+         */
+        template <class visitor_type>
+        void scan (const float &IN_QUERY, const float &IN_WEIGHT, const float &IN_BOUND, const visitor_type &IN_VISIT) const {
+            const std::size_t n = this->keys.size();
+            std::size_t right = static_cast<std::size_t>(std::distance(this->keys.begin(),
+                                                                       std::lower_bound(this->keys.begin(), this->keys.end(), IN_QUERY)));
+            std::size_t left = right;
+            float bound = IN_BOUND;
+
+            while (left > 0 || right < n) {
+                const bool take_right = left == 0 || (right < n && this->keys[right] - IN_QUERY < IN_QUERY - this->keys[left - 1]);
+                const std::size_t position = take_right ? right++ : --left;
+                const float distance = (this->keys[position] - IN_QUERY) * IN_WEIGHT;
+                if (distance * distance > bound) return;
+                bound = IN_VISIT(this->order[position]);
+            }
+        }
+
+        /**
+         * @brief Writes the sorted values to the current section of @p OUT_WRITER: their count as std::uint64_t, the
+         * values and their row indices.
+         */
+        void write (itp::store_writer &OUT_WRITER) const {
+            const std::uint64_t count = this->keys.size();
+            OUT_WRITER.write(&count, sizeof(count));
+            OUT_WRITER.write(this->keys.data(), this->keys.size() * sizeof(float));
+            OUT_WRITER.write(this->order.data(), this->order.size() * sizeof(index_type));
+        }
+
+        /**
+         * @brief Reads sorted values written by `write` from @p IN_READER.
+         *
+         * @throw std::runtime_error Thrown if the values are not sorted or do not cover exactly @p IN_TRAINING_DATA_SIZE
+         * training points.
+         */
+        void read (itp::section_reader &IN_READER, const std::size_t &IN_TRAINING_DATA_SIZE) {
+            const auto count = IN_READER.read<std::uint64_t>();
+            if (count != IN_TRAINING_DATA_SIZE) throw std::runtime_error("Stored sorted axis does not match the training data");
+            std::vector<float> new_keys = IN_READER.read_vector<float>(count);
+            std::vector<index_type> new_order = IN_READER.read_vector<index_type>(count);
+            if (!std::is_sorted(new_keys.begin(), new_keys.end()) ||
+                std::any_of(new_order.begin(), new_order.end(), [&count] (const index_type IN_ROW) -> bool { return IN_ROW >= count; })) {
+                throw std::runtime_error("Stored sorted axis is invalid");
+            }
+            this->keys = std::move(new_keys);
+            this->order = std::move(new_order);
+        }
+
+        [[nodiscard]] std::size_t size () const noexcept {
+            return this->keys.size();
+        }
+
+        [[nodiscard]] bool empty () const noexcept {
+            return this->keys.empty();
+        }
+
+    private:
+        /** @brief Training point values in increasing order */
+        std::vector<float> keys;
+
+        /** @brief Row index of every sorted value in the training points */
+        std::vector<index_type> order;
+    };
+}
+
+#endif //CONCEPTUAL_SORTED_AXIS_H
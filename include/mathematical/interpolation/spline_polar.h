@@ -0,0 +1,222 @@
+/**
+ * @file spline_polar.h
+ * @brief Header file defining the spline_polar class, smoothing spline fits of airfoil polars with analytic alpha derivatives.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_SPLINE_POLAR_H
+#define CONCEPTUAL_SPLINE_POLAR_H
+
+#include <iostream>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Dense"
+
+namespace itp {
+/**
+ * @class spline_polar
+ * @brief Smoothing cubic splines over alpha, one per Re slice of a polar, blended linearly in log(Re).
+ *
+ * @details Every slice is fitted with a Reinsch smoothing spline, the natural cubic spline f minimising
+ * sum (y_i - f(alpha_i))^2 + smoothing * integral f''(alpha)^2. A smoothing of zero interpolates the data. Unlike the
+ * k-nearest points average, the fit is C2 continuous in alpha, so its derivative is available analytically and is
+ * well suited to gradient based optimisers. A query costs one binary search over the Re slices and one over the alpha
+ * knots of the two enclosing slices. Outside the data the fit is clamped in Re and continued linearly in alpha.
+ */
+    class spline_polar {
+    public:
+        spline_polar () = default;
+        virtual ~spline_polar () = default;
+
+        /**
+         * @brief Fits the splines.
+         *
+         * @details The points are grouped by their exact Re value. Points of a slice with the same alpha are averaged.
+         *
+         * @param [in] IN_ALPHA Angle of attack of every training point.
+         * @param [in] IN_RE Reynolds number of every training point.
+         * @param [in] IN_VALUES Function value (CL, CD, ...) at every training point.
+         * @param [in] IN_SMOOTHING Weight of the curvature penalty, in (alpha unit)^3 and independent of the scale of the
+         * values. 0 interpolates.
+         *
+         * @throw std::invalid_argument Thrown if the inputs differ in size, are empty, or the smoothing is negative.
+         */
+        template <typename derived1, typename derived2, typename derived3>
+        void build (const Eigen::MatrixBase<derived1> &IN_ALPHA, const Eigen::MatrixBase<derived2> &IN_RE,
+                    const Eigen::MatrixBase<derived3> &IN_VALUES, const float &IN_SMOOTHING = 0.0f) {
+            if (IN_ALPHA.size() != IN_RE.size() || IN_ALPHA.size() != IN_VALUES.size() || IN_ALPHA.size() == 0) {
+                throw std::invalid_argument("Spline polar needs the same, non-zero number of alpha, Re and values");
+            }
+            if (IN_SMOOTHING < 0.0f) throw std::invalid_argument("Spline smoothing needs to be non-negative");
+
+            std::vector<std::size_t> order(static_cast<std::size_t>(IN_ALPHA.size()));
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&IN_ALPHA, &IN_RE] (const std::size_t i, const std::size_t j) -> bool {
+                return IN_RE(i) < IN_RE(j) || (IN_RE(i) == IN_RE(j) && IN_ALPHA(i) < IN_ALPHA(j));
+            });
+
+            this->log_re.clear();
+            this->slices.clear();
+            for (std::size_t begin = 0; begin < order.size();) {
+                std::size_t end = begin;
+                std::vector<float> x, y;
+                std::vector<std::size_t> count;
+                for (; end < order.size() && IN_RE(order[end]) == IN_RE(order[begin]); end++) {
+                    const float alpha = IN_ALPHA(order[end]);
+                    if (!x.empty() && x.back() == alpha) {
+                        y.back() += IN_VALUES(order[end]);
+                        count.back()++;
+                        continue;
+                    }
+                    x.push_back(alpha);
+                    y.push_back(IN_VALUES(order[end]));
+                    count.push_back(1);
+                }
+                for (std::size_t i = 0; i < y.size(); i++) y[i] /= static_cast<float>(count[i]);
+
+                this->log_re.push_back(std::log(std::max(static_cast<float>(IN_RE(order[begin])), std::numeric_limits<float>::min())));
+                this->slices.push_back(fit(std::move(x), std::move(y), IN_SMOOTHING));
+                begin = end;
+            }
+        }
+
+        /**
+         * @brief Evaluates the fit and its alpha derivative.
+         *
+         * @param [in] IN_ALPHA Angle of attack.
+         * @param [in] IN_RE Reynolds number.
+         * @return The value and its derivative with respect to alpha.
+         */
+        [[nodiscard]] std::pair<float, float> eval (const float &IN_ALPHA, const float &IN_RE) const noexcept {
+            if (this->slices.empty()) return {0.0f, 0.0f};
+
+            const float x = std::log(std::max(IN_RE, std::numeric_limits<float>::min()));
+            if (this->slices.size() == 1 || x <= this->log_re.front()) return this->slices.front().eval(IN_ALPHA);
+            if (x >= this->log_re.back()) return this->slices.back().eval(IN_ALPHA);
+
+            const auto upper = static_cast<std::size_t>(std::distance(this->log_re.begin(),
+                                                                      std::upper_bound(this->log_re.begin(), this->log_re.end(), x)));
+            const float fraction = (x - this->log_re[upper - 1]) / (this->log_re[upper] - this->log_re[upper - 1]);
+            const auto [lower_value, lower_slope] = this->slices[upper - 1].eval(IN_ALPHA);
+            const auto [upper_value, upper_slope] = this->slices[upper].eval(IN_ALPHA);
+            return {lower_value + fraction * (upper_value - lower_value), lower_slope + fraction * (upper_slope - lower_slope)};
+        }
+
+        [[nodiscard]] bool empty () const noexcept {
+            return this->slices.empty();
+        }
+
+    private:
+        /**
+         * @brief Natural cubic spline of one Re slice, as knot values and second derivatives.
+         */
+        struct slice {
+            std::vector<float> knots, values, curvatures;
+
+            [[nodiscard]] std::pair<float, float> eval (const float &IN_ALPHA) const noexcept {
+                const std::size_t n = this->knots.size();
+                if (n == 1) return {this->values.front(), 0.0f};
+
+                const std::size_t i = IN_ALPHA <= this->knots.front() ? 0 : IN_ALPHA >= this->knots.back() ? n - 2 :
+                        static_cast<std::size_t>(std::distance(this->knots.begin(),
+                                                               std::upper_bound(this->knots.begin(), this->knots.end(), IN_ALPHA))) - 1;
+                const float h = this->knots[i + 1] - this->knots[i];
+                const float slope = (this->values[i + 1] - this->values[i]) / h - h * (2.0f * this->curvatures[i] + this->curvatures[i + 1]) / 6.0f;
+
+                if (IN_ALPHA <= this->knots.front()) {
+                    return {this->values.front() + slope * (IN_ALPHA - this->knots.front()), slope};
+                }
+                if (IN_ALPHA >= this->knots.back()) {
+                    const float end_slope = slope + h * (this->curvatures[i] + this->curvatures[i + 1]) / 2.0f;
+                    return {this->values.back() + end_slope * (IN_ALPHA - this->knots.back()), end_slope};
+                }
+
+                const float t = IN_ALPHA - this->knots[i];
+                const float jerk = (this->curvatures[i + 1] - this->curvatures[i]) / h;
+                return {this->values[i] + t * (slope + t * (this->curvatures[i] / 2.0f + t * jerk / 6.0f)),
+                        slope + t * (this->curvatures[i] + t * jerk / 2.0f)};
+            }
+        };
+
+        /** @brief log(Re) of every slice, strictly increasing */
+        std::vector<float> log_re;
+        std::vector<slice> slices;
+
+        /**
+         * @brief Reinsch smoothing spline through (@p IN_X, @p IN_Y), @p IN_X strictly increasing.
+         *
+         * @details Solves (R + smoothing * Q^T Q) gamma = Q^T y for the interior second derivatives gamma, with Q the
+         * second difference matrix and R the tridiagonal spline matrix, then smooths the values with
+         * y - smoothing * Q gamma. The system is pentadiagonal, symmetric and positive definite, so a banded LDL^T
+         * factorisation solves it in O(n).
+         */
+        static slice fit (std::vector<float> IN_X, std::vector<float> IN_Y, const float &IN_SMOOTHING) {
+            const std::size_t n = IN_X.size();
+            slice OUT_SLICE{std::move(IN_X), std::move(IN_Y), std::vector<float>(n, 0.0f)};
+            if (n < 3) return OUT_SLICE;
+
+            const std::vector<float> &x = OUT_SLICE.knots;
+            std::vector<float> &y = OUT_SLICE.values;
+            const std::size_t m = n - 2;
+            const double lambda = IN_SMOOTHING;
+
+            // columns of Q: rows i, i + 1, i + 2 hold q0, q1, q2
+            std::vector<double> q0(m), q1(m), q2(m);
+            for (std::size_t i = 0; i < m; i++) {
+                const double h0 = x[i + 1] - x[i], h1 = x[i + 2] - x[i + 1];
+                q0[i] = 1.0 / h0;
+                q1[i] = -1.0 / h0 - 1.0 / h1;
+                q2[i] = 1.0 / h1;
+            }
+
+            // bands of R + lambda * Q^T Q and the right hand side Q^T y
+            std::vector<double> d(m), e(m, 0.0), f(m, 0.0), r(m);
+            for (std::size_t i = 0; i < m; i++) {
+                const double h0 = x[i + 1] - x[i], h1 = x[i + 2] - x[i + 1];
+                d[i] = (h0 + h1) / 3.0 + lambda * (q0[i] * q0[i] + q1[i] * q1[i] + q2[i] * q2[i]);
+                if (i + 1 < m) e[i] = h1 / 6.0 + lambda * (q1[i] * q0[i + 1] + q2[i] * q1[i + 1]);
+                if (i + 2 < m) f[i] = lambda * q2[i] * q0[i + 2];
+                r[i] = q0[i] * y[i] + q1[i] * y[i + 1] + q2[i] * y[i + 2];
+            }
+
+            // banded LDL^T, L has unit diagonal and sub-diagonals u, v
+            std::vector<double> diagonal(m), u(m, 0.0), v(m, 0.0);
+            for (std::size_t i = 0; i < m; i++) {
+                diagonal[i] = d[i];
+                if (i >= 1) diagonal[i] -= u[i - 1] * u[i - 1] * diagonal[i - 1];
+                if (i >= 2) diagonal[i] -= v[i - 2] * v[i - 2] * diagonal[i - 2];
+                u[i] = (e[i] - (i >= 1 ? u[i - 1] * v[i - 1] * diagonal[i - 1] : 0.0)) / diagonal[i];
+                v[i] = f[i] / diagonal[i];
+            }
+            for (std::size_t i = 0; i < m; i++) {
+                if (i >= 1) r[i] -= u[i - 1] * r[i - 1];
+                if (i >= 2) r[i] -= v[i - 2] * r[i - 2];
+            }
+            for (std::size_t i = 0; i < m; i++) r[i] /= diagonal[i];
+            for (std::size_t i = m; i-- > 0;) {
+                if (i + 1 < m) r[i] -= u[i] * r[i + 1];
+                if (i + 2 < m) r[i] -= v[i] * r[i + 2];
+            }
+
+            for (std::size_t i = 0; i < m; i++) {
+                OUT_SLICE.curvatures[i + 1] = static_cast<float>(r[i]);
+                y[i] -= static_cast<float>(lambda * q0[i] * r[i]);
+                y[i + 1] -= static_cast<float>(lambda * q1[i] * r[i]);
+                y[i + 2] -= static_cast<float>(lambda * q2[i] * r[i]);
+            }
+            return OUT_SLICE;
+        }
+    };
+}
+
+#endif //CONCEPTUAL_SPLINE_POLAR_H
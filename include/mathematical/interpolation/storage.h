@@ -0,0 +1,111 @@
+/**
+ * @file storage.h
+ * @brief Header file defining the storage policies of the training data of the interpolate class.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_STORAGE_H
+#define CONCEPTUAL_STORAGE_H
+
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "eigen3/Eigen/Core"
+#include "eigen3/Eigen/Dense"
+
+namespace itp {
+/**
+ * @struct fixed_storage
+ * @brief Training data held in matrices of compile-time size `max_training_data_size`.
+ *
+ * @details The full capacity is allocated on construction, whatever amount of training data is added later. This is
+ * the default policy of the interpolate class.
+ */
+    struct fixed_storage {
+        template <std::size_t rows, std::size_t cols>
+        using matrix = Eigen::Matrix<float, static_cast<int>(rows), static_cast<int>(cols)>;
+
+        static constexpr bool resizable = false;
+        static constexpr bool mapped = false;
+    };
+
+/**
+ * @struct runtime_storage
+ * @brief Training data held in heap matrices with a runtime number of rows.
+ *
+ * @details The storage starts empty and grows to exactly the amount of training data added. `max_training_data_size`
+ * only remains an upper bound. The number of columns stays a compile-time constant, so the distance kernels of the
+ * interpolate class are unaffected. Unlike EIGEN_USE_DYNAMIC, the policy is chosen per interpolator.
+ */
+    struct runtime_storage {
+        template <std::size_t rows, std::size_t cols>
+        using matrix = Eigen::Matrix<float, Eigen::Dynamic, static_cast<int>(cols)>;
+
+        static constexpr bool resizable = true;
+        static constexpr bool mapped = false;
+    };
+
+/**
+ * @struct mapped_storage
+ * @brief Read-only training data mapped in place from a training store (see itp::mapped_store).
+ *
+ * @details The matrices are Eigen::Map views of the mapped file, so loading costs no copy and processes mapping the
+ * same store share its pages. The training data cannot be added to; an interpolator with this policy is built with the
+ * training store constructor of the interpolate class.
+ */
+    struct mapped_storage {
+        template <std::size_t rows, std::size_t cols>
+        using matrix = Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, static_cast<int>(cols)>>;
+
+        static constexpr bool resizable = false;
+        static constexpr bool mapped = true;
+    };
+
+/**
+ * @struct bfloat16_storage
+ * @brief Training data held in heap matrices of Eigen::bfloat16, half the size of itp::runtime_storage.
+ *
+ * @details bfloat16 keeps the 8 bit exponent of float, so quantities spanning decades such as Re need no per-axis
+ * scale, and drops the mantissa to 8 significant bits, a relative rounding error of at most 2^-9 (0.2 %). Typical
+ * angle of attack steps of 0.25 or 0.5 degrees are exact up to 32 or 64 degrees. Values are rounded to nearest on
+ * insertion and widened back to float exactly, by a shift, inside the distance kernel of the interpolate class, so
+ * distances and means are still computed in float. Grows like itp::runtime_storage.
+ *
+ * @note Halves the memory traffic of full scans. With AVX2 or wider builds, scans of training sets larger than the
+ * last level cache get faster, those that fit in cache get slightly slower due to the widening. The kd-tree index, grid and prescaled metric keep
+ * their own float data, and query the training points through a float cast.
+ */
+    struct bfloat16_storage {
+        template <std::size_t rows, std::size_t cols>
+        using matrix = Eigen::Matrix<Eigen::bfloat16, Eigen::Dynamic, static_cast<int>(cols)>;
+
+        static constexpr bool resizable = true;
+        static constexpr bool mapped = false;
+
+        /** @brief Fixed trip count of the inner loop of `widen`, which lets compilers vectorise it at -O2 */
+        static constexpr std::size_t widen_step = 16;
+
+        /**
+         * @brief Widens @p IN_LENGTH values of @p IN_VALUES to float. Written on the raw bits, so compilers vectorise it.
+         */
+        static void widen (const Eigen::bfloat16 *IN_VALUES, const std::size_t &IN_LENGTH, float *OUT_VALUES) noexcept {
+            std::size_t i = 0;
+            for (; i + widen_step <= IN_LENGTH; i += widen_step) {
+                for (std::size_t j = i; j < i + widen_step; j++) {
+                    const std::uint32_t bits = static_cast<std::uint32_t>(IN_VALUES[j].value) << 16;
+                    std::memcpy(OUT_VALUES + j, &bits, sizeof(float));
+                }
+            }
+            for (; i < IN_LENGTH; i++) {
+                const std::uint32_t bits = static_cast<std::uint32_t>(IN_VALUES[i].value) << 16;
+                std::memcpy(OUT_VALUES + i, &bits, sizeof(float));
+            }
+        }
+    };
+}
+
+#endif //CONCEPTUAL_STORAGE_H
@@ -0,0 +1,110 @@
+/**
+ * @file top_k.h
+ * @brief Header file defining the top_k selector for the k-nearest points searches of the interpolate class.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_TOP_K_H
+#define CONCEPTUAL_TOP_K_H
+
+#include <iostream>
+#include <array>
+#include <limits>
+#include <cstddef>
+
+namespace itp {
+/**
+ * @class top_k
+ * @brief Fixed capacity selector keeping the k smallest (distance, index) pairs pushed into it.
+ *
+ * @details The pairs are kept sorted in two fixed-size arrays, ordered by distance and then by index. Equal distances
+ * are common on tensor-product data, and the index order makes the kept pairs independent of the order they are
+ * pushed in, so every search that offers all pairs up to the k-th distance selects the same points. A push is rejected
+ * with one comparison against the current k-th distance, which is the common case once the selector is full, and is
+ * otherwise placed with an insertion step over at most k entries. Each distance is computed once by the caller and
+ * stored, so the weighting step can reuse it without recomputing.
+ *
+ * @tparam k Number of pairs to keep (the `mean_size` of the interpolate class).
+ */
+    template <std::size_t k>
+    class top_k {
+        static_assert(k > 0, "top_k needs to keep at least one element");
+    public:
+        top_k () noexcept {
+            this->distances.fill(std::numeric_limits<float>::infinity());
+            this->indices.fill(0);
+        }
+
+        /**
+         * @brief Offers a (distance, index) pair to the selector.
+         *
+         * @param [in] IN_DISTANCE Distance of the training point. Any monotonic measure of distance works, as long as
+         * all pushes use the same one.
+         * @param [in] IN_INDEX Index of the training point.
+         */
+        void push (const float IN_DISTANCE, const std::size_t IN_INDEX) noexcept {
+            if (!precedes(IN_DISTANCE, IN_INDEX, this->distances[k - 1], this->indices[k - 1])) return;
+
+            std::size_t i = k - 1;
+            for (; i > 0 && precedes(IN_DISTANCE, IN_INDEX, this->distances[i - 1], this->indices[i - 1]); i--) {
+                this->distances[i] = this->distances[i - 1];
+                this->indices[i] = this->indices[i - 1];
+            }
+            this->distances[i] = IN_DISTANCE;
+            this->indices[i] = IN_INDEX;
+            if (this->count < k) this->count++;
+        }
+
+        /**
+         * @brief Merges the pairs of another selector into this one.
+         *
+         * @param [in] IN_OTHER Selector filled over a different set of training points.
+         */
+        void merge (const top_k &IN_OTHER) noexcept {
+            for (std::size_t i = 0; i < IN_OTHER.count; i++) this->push(IN_OTHER.distances[i], IN_OTHER.indices[i]);
+        }
+
+        /**
+         * @return The k-th smallest distance so far, infinity until k pairs are pushed. Pairs beyond this distance are
+         * rejected, pairs at it only if their index is larger, so searches may prune points strictly beyond it only.
+         */
+        [[nodiscard]] float worst () const noexcept {
+            return this->distances[k - 1];
+        }
+
+        [[nodiscard]] std::size_t size () const noexcept {
+            return this->count;
+        }
+
+        [[nodiscard]] float distance (const std::size_t &IN_POSITION) const noexcept {
+            return this->distances[IN_POSITION];
+        }
+
+        [[nodiscard]] std::size_t index (const std::size_t &IN_POSITION) const noexcept {
+            return this->indices[IN_POSITION];
+        }
+
+    private:
+        /** @brief Kept distances in increasing order, infinity for unused slots */
+        std::array<float, k> distances;
+
+        /** @brief Training point index of every kept distance */
+        std::array<std::size_t, k> indices;
+
+        /** @brief Number of used slots */
+        std::size_t count = 0;
+
+        /**
+         * @return true if (IN_DISTANCE, IN_INDEX) is ordered before (IN_OTHER_DISTANCE, IN_OTHER_INDEX). Unused slots
+         * hold (infinity, 0), so infinite and NaN distances are never kept.
+         */
+        static bool precedes (const float IN_DISTANCE, const std::size_t IN_INDEX, const float IN_OTHER_DISTANCE,
+                              const std::size_t IN_OTHER_INDEX) noexcept {
+            return IN_DISTANCE < IN_OTHER_DISTANCE || (IN_DISTANCE == IN_OTHER_DISTANCE && IN_INDEX < IN_OTHER_INDEX);
+        }
+    };
+}
+
+#endif //CONCEPTUAL_TOP_K_H
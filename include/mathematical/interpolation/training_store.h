@@ -0,0 +1,383 @@
+/**
+ * @file training_store.h
+ * @brief Header file defining the versioned binary on-disk layout of interpolate training data, its writer and its
+ * read-only memory-mapped reader.
+ *
+ * @author Harshavardhan Karnati
+ * @date 17/10/2026
+ */
+
+#ifndef CONCEPTUAL_TRAINING_STORE_H
+#define CONCEPTUAL_TRAINING_STORE_H
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <array>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <stdexcept>
+#include <random>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace itp {
+    static_assert(std::numeric_limits<float>::is_iec559, "Training stores hold IEEE 754 single precision floats");
+
+/**
+ * @brief Kinds of sections of a training store.
+ */
+    enum class store_section : std::uint32_t {
+        /** @brief Function values, `training_data_size` floats */
+        func_data = 1,
+
+        /** @brief Training points, column-major, `training_data_size` rows by `dimension` columns of floats */
+        var_data = 2,
+
+        /** @brief Major axis factors of the metric, `dimension` floats */
+        scaling_factors = 3,
+
+        /** @brief kd-tree index, see kd_tree::write */
+        kd_tree = 4,
+
+        /** @brief Rectilinear grid, see rectilinear_grid::write */
+        grid = 5,
+
+        /** @brief Settings of the prescaled metric, see prescaled_metric::write. The transformed points are rebuilt */
+        prescaled_metric = 6,
+
+        /** @brief Projection axis as a std::uint64_t followed by its sorted_axis, see sorted_axis::write */
+        projection = 7,
+
+        /** @brief Sorted training points of one-dimensional interpolators, see sorted_axis::write */
+        sorted_axis = 8
+    };
+
+/**
+ * @brief Fixed header at the start of every training store.
+ *
+ * @details Layout (native byte order, which is recorded and checked):
+ *  - store_header, 48 bytes.
+ *  - Section payloads, each starting at a multiple of `store_alignment` bytes so that mapped floats are aligned for
+ *    vector loads.
+ *  - Section table at `table_offset`, `section_count` store_section_entry records.
+ * The header is written last, so an interrupted write leaves a file that is rejected on load. Readers look sections up
+ * by type and skip the ones they do not need, so stores with query structure sections load as plain training data.
+ */
+    struct store_header {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t byte_order;
+        std::uint32_t dimension;
+        std::uint32_t section_count;
+        std::uint64_t training_data_size;
+        std::uint64_t table_offset;
+        std::uint64_t reserved;
+    };
+
+    struct store_section_entry {
+        std::uint32_t type;
+        std::uint32_t reserved;
+        std::uint64_t offset;
+        std::uint64_t size;
+    };
+
+    static_assert(sizeof(store_header) == 48 && std::is_trivially_copyable_v<store_header>);
+    static_assert(sizeof(store_section_entry) == 24 && std::is_trivially_copyable_v<store_section_entry>);
+
+    inline constexpr std::array<char, 8> store_magic{'I', 'T', 'P', 'S', 'T', 'O', 'R', 'E'};
+    inline constexpr std::uint32_t store_version = 1;
+    inline constexpr std::uint32_t store_byte_order = 0x01020304;
+    inline constexpr std::size_t store_alignment = 64;
+
+    /**
+     * @brief Temporary file name next to @p IN_PATH, unique to the calling process and call, so that concurrent writers
+     * of the same destination, in one or several processes, never share a temporary file.
+     *
+     * @return @p IN_PATH followed by ".tmp.", the process id and a random suffix.
+     */
+    inline std::filesystem::path temporary_path_for (const std::filesystem::path &IN_PATH) {
+        thread_local std::mt19937_64 generator{std::random_device{}()};
+        std::ostringstream name;
+        name << IN_PATH.string() << ".tmp." << ::getpid() << "." << std::hex << generator();
+        return name.str();
+    }
+
+/**
+ * @class store_writer
+ * @brief Streams the sections of a training store to disk.
+ *
+ * @details The store is written to a temporary file next to the destination and renamed over it by `finish`, so
+ * processes mapping an older version of the file keep a consistent view and readers never see a partial file.
+ */
+    class store_writer {
+    public:
+        /**
+         * @throw std::runtime_error Thrown if the temporary file cannot be created.
+         */
+        store_writer (const std::filesystem::path &IN_PATH, const std::size_t &IN_DIMENSION, const std::size_t &IN_TRAINING_DATA_SIZE)
+                : path(IN_PATH), temporary_path(itp::temporary_path_for(IN_PATH)), dimension(IN_DIMENSION), training_data_size(IN_TRAINING_DATA_SIZE) {
+            this->file.open(this->temporary_path, std::ios::binary | std::ios::trunc);
+            if (!this->file.is_open()) throw std::runtime_error("Could not open training store for writing: " + this->temporary_path.string());
+            this->pad(sizeof(store_header));
+        }
+
+        virtual ~store_writer () {
+            if (this->file.is_open()) {
+                this->file.close();
+                std::error_code error;
+                std::filesystem::remove(this->temporary_path, error);
+            }
+        }
+
+        store_writer (const store_writer&) = delete;
+        store_writer& operator= (const store_writer&) = delete;
+
+        /**
+         * @brief Starts a new section, aligned to `store_alignment`. The following `write` calls fill it.
+         */
+        void begin_section (const store_section &IN_TYPE) {
+            this->pad(align(this->position));
+            this->sections.push_back(store_section_entry{static_cast<std::uint32_t>(IN_TYPE), 0, this->position, 0});
+        }
+
+        void write (const void *IN_DATA, const std::size_t &IN_BYTES) {
+            if (this->sections.empty()) throw std::logic_error("Training store data written outside of a section");
+            this->file.write(static_cast<const char*>(IN_DATA), static_cast<std::streamsize>(IN_BYTES));
+            this->position += IN_BYTES;
+            this->sections.back().size += IN_BYTES;
+        }
+
+        /**
+         * @brief Writes the section table and the header, then moves the store to its destination.
+         *
+         * @throw std::runtime_error Thrown if any write failed.
+         */
+        void finish () {
+            this->pad(align(this->position));
+            const std::uint64_t table_offset = this->position;
+            this->file.write(reinterpret_cast<const char*>(this->sections.data()),
+                             static_cast<std::streamsize>(this->sections.size() * sizeof(store_section_entry)));
+
+            const store_header header{store_magic, store_version, store_byte_order, static_cast<std::uint32_t>(this->dimension),
+                                      static_cast<std::uint32_t>(this->sections.size()), this->training_data_size, table_offset, 0};
+            this->file.seekp(0);
+            this->file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            this->file.close();
+            if (this->file.fail()) {
+                std::error_code error;
+                std::filesystem::remove(this->temporary_path, error);
+                throw std::runtime_error("Could not write training store: " + this->temporary_path.string());
+            }
+            std::filesystem::rename(this->temporary_path, this->path);
+        }
+
+    private:
+        std::filesystem::path path;
+        std::filesystem::path temporary_path;
+        std::ofstream file;
+        std::size_t dimension;
+        std::uint64_t training_data_size;
+        std::uint64_t position = 0;
+        std::vector<store_section_entry> sections;
+
+        static std::uint64_t align (const std::uint64_t &IN_OFFSET) noexcept {
+            return (IN_OFFSET + store_alignment - 1) / store_alignment * store_alignment;
+        }
+
+        void pad (const std::uint64_t &IN_OFFSET) {
+            static constexpr std::array<char, store_alignment> zeros{};
+            while (this->position < IN_OFFSET) {
+                const std::uint64_t length = std::min<std::uint64_t>(IN_OFFSET - this->position, zeros.size());
+                this->file.write(zeros.data(), static_cast<std::streamsize>(length));
+                this->position += length;
+            }
+        }
+    };
+
+/**
+ * @class section_reader
+ * @brief Sequential reader of a section payload, checked against its size.
+ *
+ * @details Values are copied out with std::memcpy, so payloads need no alignment beyond `store_alignment` for the
+ * section start.
+ */
+    class section_reader {
+    public:
+        explicit section_reader (const std::span<const std::byte> &IN_PAYLOAD) noexcept : payload(IN_PAYLOAD) {}
+
+        /**
+         * @throw std::runtime_error Thrown if fewer than @p IN_COUNT values are left.
+         */
+        template <class type>
+        requires (std::is_trivially_copyable_v<type>)
+        void read (type *OUT_VALUES, const std::size_t &IN_COUNT) {
+            if (IN_COUNT > (this->payload.size() - this->position) / sizeof(type)) {
+                throw std::runtime_error("Training store section is truncated");
+            }
+            if (IN_COUNT != 0) std::memcpy(OUT_VALUES, this->payload.data() + this->position, IN_COUNT * sizeof(type));
+            this->position += IN_COUNT * sizeof(type);
+        }
+
+        template <class type>
+        requires (std::is_trivially_copyable_v<type>)
+        type read () {
+            type OUT_VALUE{};
+            this->read(&OUT_VALUE, 1);
+            return OUT_VALUE;
+        }
+
+        /**
+         * @brief Reads @p IN_COUNT values, checking the size before allocating.
+         */
+        template <class type>
+        requires (std::is_trivially_copyable_v<type>)
+        std::vector<type> read_vector (const std::uint64_t &IN_COUNT) {
+            if (IN_COUNT > (this->payload.size() - this->position) / sizeof(type)) {
+                throw std::runtime_error("Training store section is truncated");
+            }
+            std::vector<type> OUT_VALUES(static_cast<std::size_t>(IN_COUNT));
+            this->read(OUT_VALUES.data(), OUT_VALUES.size());
+            return OUT_VALUES;
+        }
+
+        /**
+         * @throw std::runtime_error Thrown if the payload holds more than was read.
+         */
+        void expect_end () const {
+            if (this->position != this->payload.size()) throw std::runtime_error("Training store section has unexpected trailing data");
+        }
+
+    private:
+        std::span<const std::byte> payload;
+        std::size_t position = 0;
+    };
+
+/**
+ * @class mapped_store
+ * @brief Read-only memory mapping of a training store.
+ *
+ * @details The file is mapped shared and read-only, so every process mapping the same store shares one copy of it in
+ * the page cache and only touched pages are read from disk. The header and the section table are validated on
+ * construction; section payloads are used in place.
+ */
+    class mapped_store {
+    public:
+        /**
+         * @throw std::runtime_error Thrown if the file cannot be mapped or is not a valid training store of this version.
+         */
+        explicit mapped_store (const std::filesystem::path &IN_PATH) {
+            const int descriptor = ::open(IN_PATH.c_str(), O_RDONLY);
+            if (descriptor < 0) throw std::runtime_error("Could not open training store: " + IN_PATH.string());
+
+            struct stat status{};
+            if (::fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(store_header)) {
+                ::close(descriptor);
+                throw std::runtime_error("Training store is too small: " + IN_PATH.string());
+            }
+            this->length = static_cast<std::size_t>(status.st_size);
+            void *address = ::mmap(nullptr, this->length, PROT_READ, MAP_SHARED, descriptor, 0);
+            ::close(descriptor);
+            if (address == MAP_FAILED) throw std::runtime_error("Could not map training store: " + IN_PATH.string());
+            this->base = static_cast<const std::byte*>(address);
+
+            try {
+                this->validate(IN_PATH);
+            } catch (...) {
+                ::munmap(const_cast<std::byte*>(this->base), this->length);
+                throw;
+            }
+        }
+
+        virtual ~mapped_store () {
+            ::munmap(const_cast<std::byte*>(this->base), this->length);
+        }
+
+        mapped_store (const mapped_store&) = delete;
+        mapped_store& operator= (const mapped_store&) = delete;
+
+        [[nodiscard]] std::size_t get_dimension () const noexcept {
+            return this->header.dimension;
+        }
+
+        [[nodiscard]] std::size_t get_training_data_size () const noexcept {
+            return static_cast<std::size_t>(this->header.training_data_size);
+        }
+
+        [[nodiscard]] bool has_section (const store_section &IN_TYPE) const noexcept {
+            return this->find(IN_TYPE) != nullptr;
+        }
+
+        /**
+         * @return Payload of the first section of type @p IN_TYPE, empty if there is none.
+         */
+        [[nodiscard]] std::span<const std::byte> section (const store_section &IN_TYPE) const noexcept {
+            const store_section_entry *entry = this->find(IN_TYPE);
+            if (entry == nullptr) return {};
+            return {this->base + entry->offset, static_cast<std::size_t>(entry->size)};
+        }
+
+        /**
+         * @return Payload of section @p IN_TYPE as @p IN_COUNT floats.
+         *
+         * @throw std::runtime_error Thrown if the section is missing or not exactly @p IN_COUNT floats long.
+         */
+        [[nodiscard]] const float* floats (const store_section &IN_TYPE, const std::size_t &IN_COUNT) const {
+            const std::span<const std::byte> payload = this->section(IN_TYPE);
+            if (!this->has_section(IN_TYPE) || payload.size() != IN_COUNT * sizeof(float)) {
+                throw std::runtime_error("Training store section " + std::to_string(static_cast<std::uint32_t>(IN_TYPE)) +
+                                         " is missing or has an unexpected size");
+            }
+            return reinterpret_cast<const float*>(payload.data());
+        }
+
+    private:
+        const std::byte *base = nullptr;
+        std::size_t length = 0;
+        store_header header{};
+        std::vector<store_section_entry> table;
+
+        [[nodiscard]] const store_section_entry* find (const store_section &IN_TYPE) const noexcept {
+            for (const store_section_entry &entry : this->table) {
+                if (entry.type == static_cast<std::uint32_t>(IN_TYPE)) return &entry;
+            }
+            return nullptr;
+        }
+
+        void validate (const std::filesystem::path &IN_PATH) {
+            std::memcpy(&this->header, this->base, sizeof(store_header));
+            if (this->header.magic != store_magic) throw std::runtime_error("Not a training store: " + IN_PATH.string());
+            if (this->header.byte_order != store_byte_order) {
+                throw std::runtime_error("Training store was written with a different byte order: " + IN_PATH.string());
+            }
+            if (this->header.version != store_version) {
+                throw std::runtime_error("Unsupported training store version " + std::to_string(this->header.version) + ": " + IN_PATH.string());
+            }
+
+            const std::uint64_t table_bytes = static_cast<std::uint64_t>(this->header.section_count) * sizeof(store_section_entry);
+            if (this->header.table_offset > this->length || table_bytes > this->length - this->header.table_offset) {
+                throw std::runtime_error("Training store section table is out of bounds: " + IN_PATH.string());
+            }
+            this->table.resize(this->header.section_count);
+            std::memcpy(this->table.data(), this->base + this->header.table_offset, table_bytes);
+            for (const store_section_entry &entry : this->table) {
+                if (entry.offset % store_alignment != 0 || entry.offset > this->length || entry.size > this->length - entry.offset) {
+                    throw std::runtime_error("Training store section is out of bounds: " + IN_PATH.string());
+                }
+            }
+        }
+    };
+}
+
+#endif //CONCEPTUAL_TRAINING_STORE_H
@@ -108,10 +108,15 @@ namespace concpt {
                         this->airfoil_polars = std::forward<sectionalData>(IN_BLADE_SECTIONAL_DATA).airfoil_polars;
                 }(),...);
 
-                if (!this->airfoil_polars)
-                    this->airfoil_polars = std::make_shared<concpt::airfoil_polar>(
-                            this->airfoil_names,
-                            true, true);
+                if (!this->airfoil_polars) {
+                    // airfoils are generated and built on their first query
+                    this->airfoil_polars = std::make_shared<concpt::airfoil_polar>(this->airfoil_names);
+                    this->airfoil_polars->set_lazy_build(true);
+                }
+                this->airfoil_ids.reserve(this->airfoil_names.size());
+                for (const std::string &each_airfoil : this->airfoil_names) {
+                    this->airfoil_ids.push_back(this->airfoil_polars->get_airfoil_id(each_airfoil));
+                }
             }
 
             template<class sectionalData>
@@ -131,6 +136,8 @@ namespace concpt {
                 this->airfoil_names.insert(std::ranges::next(this->airfoil_names.begin(), index + 1, this->airfoil_names.end()),
                                            std::forward<sectionalData>(IN_BLADE_SECTIONAL_DATA).airfoil_name);
                 this->airfoil_polars->add_airfoils(this->airfoil_names[index + 1]);
+                this->airfoil_ids.insert(std::ranges::next(this->airfoil_ids.begin(), index + 1, this->airfoil_ids.end()),
+                                         this->airfoil_polars->get_airfoil_id(this->airfoil_names[index + 1]));
             }
 
 
@@ -140,6 +147,7 @@ namespace concpt {
                 chord(std::move(other.chord)), sweep(std::move(other.sweep)),
                 offset(std::move(other.offset)), twist(std::move(other.twist)),
                 airfoil_locations(std::move(other.airfoil_locations)),
+                airfoil_ids(std::move(other.airfoil_ids)),
                 airfoil_polars(std::move(other.airfoil_polars)) {
                 this->radius = other.radius;
                 this->airfoil_polars.reset();
@@ -184,10 +192,10 @@ namespace concpt {
                 this->mesh_azimuthal = IN_MESH_AZIMUTHAL;
             }
 
-            std::pair<float, float> get_aero_values (const float &BLADE_LOCATION, const float &IN_ALPHA, const float &IN_RE, const float &IN_MACH, const float &IN_MULTIPLIER = 1.0f) {
-                std::string current_airfoil = this->airfoil_names[this->find_blade_index(BLADE_LOCATION)];
-                if (IN_RE < this->airfoil_polars->surrogate_hash_map.at(current_airfoil).min_Re
-                    || IN_RE > this->airfoil_polars->surrogate_hash_map.at(current_airfoil).max_Re) {
+            std::pair<float, float> get_aero_values (const float &BLADE_LOCATION, const float &IN_ALPHA, const float &IN_RE, const float &IN_MACH, const float &IN_MULTIPLIER = 1.0f) const {
+                const concpt::airfoil_id current_airfoil = this->airfoil_ids[this->find_blade_index(BLADE_LOCATION)];
+                const airfoil_surrogate_model &model = this->airfoil_polars->hash_airfoil(current_airfoil);
+                if (IN_RE < model.min_Re || IN_RE > model.max_Re) {
                     throw std::runtime_error("Reynolds number out-of-data..");
                 }
                 return this->airfoil_polars->get_aero_values(current_airfoil, IN_ALPHA, IN_RE, IN_MACH, IN_MULTIPLIER);
@@ -195,19 +203,19 @@ namespace concpt {
 
             std::pair<std::vector<std::pair<float, float>>*, std::vector<std::pair<float, float>>*>
             get_airfoil_coordinates (const float &IN_BLADE_LOCATION) {
-                std::string current_airfoil = this->airfoil_names[this->find_blade_index(IN_BLADE_LOCATION)];
-                if (this->airfoil_polars->surrogate_hash_map.at(current_airfoil).airfoil_coordinates_upper.empty() ||
-                        this->airfoil_polars->surrogate_hash_map.at(current_airfoil).airfoil_coordinates_lower.empty()) {
+                const concpt::airfoil_id current_airfoil = this->airfoil_ids[this->find_blade_index(IN_BLADE_LOCATION)];
+                if (this->airfoil_polars->hash_airfoil(current_airfoil).airfoil_coordinates_upper.empty() ||
+                        this->airfoil_polars->hash_airfoil(current_airfoil).airfoil_coordinates_lower.empty()) {
                     throw std::runtime_error("Airfoil coordinates are not available...");
                 }
-                return std::make_pair(&(this->airfoil_polars->surrogate_hash_map.at(current_airfoil).airfoil_coordinates_upper), &(this->airfoil_polars->surrogate_hash_map.at(current_airfoil).airfoil_coordinates_upper));
+                return std::make_pair(&(this->airfoil_polars->hash_airfoil(current_airfoil).airfoil_coordinates_upper), &(this->airfoil_polars->hash_airfoil(current_airfoil).airfoil_coordinates_upper));
             }
 
             std::pair<std::vector<std::pair<float, float>>, std::vector<std::pair<float, float>>>
             get_cl_cd_chord_distribution (const float &IN_BLADE_LOCATION, const float &IN_ALPHA = 0.0f, const float &IN_RE = 0.0f, const float &IN_MACH_NUMBER = 0.0f) {
-                std::string current_airfoil = this->airfoil_names[this->find_blade_index(IN_BLADE_LOCATION)];
-                auto cl_cd_dis = std::make_pair(this->airfoil_polars->surrogate_hash_map.at(current_airfoil).airfoil_coordinates_upper,
-                                                   this->airfoil_polars->surrogate_hash_map.at(current_airfoil).airfoil_coordinates_lower);
+                const concpt::airfoil_id current_airfoil = this->airfoil_ids[this->find_blade_index(IN_BLADE_LOCATION)];
+                auto cl_cd_dis = std::make_pair(this->airfoil_polars->hash_airfoil(current_airfoil).airfoil_coordinates_upper,
+                                                   this->airfoil_polars->hash_airfoil(current_airfoil).airfoil_coordinates_lower);
 
                 // TODO: currently implies uniform distribution for lift and drag. (lift assumption is wrong)
                 std::for_each(cl_cd_dis.first.begin(), cl_cd_dis.first.end(), [](auto& pair) { pair.second = 1.0f;});
@@ -217,8 +225,8 @@ namespace concpt {
             }
 
             float get_max_thickness_ratio (const float &IN_BLADE_LOCATION) {
-                std::string current_airfoil = this->airfoil_names[this->find_blade_index(IN_BLADE_LOCATION)];
-                const float max_thickness_ratio = this->airfoil_polars->surrogate_hash_map.at(current_airfoil).max_thickness_ratio;
+                const concpt::airfoil_id current_airfoil = this->airfoil_ids[this->find_blade_index(IN_BLADE_LOCATION)];
+                const float max_thickness_ratio = this->airfoil_polars->hash_airfoil(current_airfoil).max_thickness_ratio;
                 if (concpt::aux::check_equal(max_thickness_ratio, 0.0f)) {
                     throw std::runtime_error("No Thickness ratio value exists");
                 } else {
@@ -231,7 +239,7 @@ namespace concpt {
             std::size_t mesh_radius = 250, mesh_azimuthal = 1;
         private:
 
-            [[nodiscard]] std::size_t find_blade_index (const float &IN_BLADE_LOCATION) {
+            [[nodiscard]] std::size_t find_blade_index (const float &IN_BLADE_LOCATION) const {
                 auto if_ahead = [&IN_BLADE_LOCATION] (const float &IN_LOCATION) -> bool {return IN_LOCATION >= IN_BLADE_LOCATION;};
                 return std::ranges::distance(airfoil_locations.begin(),
                                              std::ranges::next(std::ranges::find_if(this->airfoil_locations.begin(),
@@ -245,6 +253,9 @@ namespace concpt {
             std::vector<float>chord, sweep, offset, twist;
             std::vector<float> airfoil_locations = {};
             std::vector<std::string> airfoil_names = {};
+
+            /** @brief Handle of every airfoil name in airfoil_polars, resolved when the section is added */
+            std::vector<concpt::airfoil_id> airfoil_ids = {};
             std::shared_ptr<concpt::airfoil_polar>airfoil_polars = nullptr;
         };
 
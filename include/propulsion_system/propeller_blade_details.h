@@ -23,6 +23,9 @@ namespace concpt::detail {
         struct section_details {
             float location, chord, sweep, offset, twist;
             std::string airfoil_name;
+
+            /** @brief Handle of `airfoil_name` in the polar of the blade, resolved when the polar is attached */
+            concpt::airfoil_id airfoil_id;
         };
     }
 
@@ -34,6 +37,13 @@ namespace concpt::detail {
         aero_results_get get_aero_results (const float &IN_LOCATION);
         std::array<std::vector<std::pair<float, float>>*, 2> get_airfoil_coordinates (const float &IN_BLADE_LOCATION);
         float get_max_thickness_ratio (const float &IN_BLADE_LOCATION);
+
+        /**
+         * @brief Attaches @p IN_AIRFOIL_POLAR and resolves the airfoil handles of every section in it.
+         *
+         * @throw std::out_of_range Thrown if the airfoil of a section is not part of @p IN_AIRFOIL_POLAR.
+         */
+        void set_airfoil_polar (std::shared_ptr<concpt::airfoil_polar> IN_AIRFOIL_POLAR);
     private:
         std::vector<concpt::detail::section_details> section_details;
         std::shared_ptr<concpt::airfoil_polar>airfoil_polar = nullptr;
@@ -59,7 +69,7 @@ namespace concpt::detail {
         const concpt::detail::blade_details &blade;
         const float &location;
 
-        bool perform_checks (const concpt::detail::section_details &IN_CURRENT_SECTION);
+        bool perform_checks (const concpt::airfoil_id &IN_AIRFOIL);
     };
 }
 
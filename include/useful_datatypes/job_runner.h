@@ -0,0 +1,223 @@
+//
+// Created by Harshavardhan Karnati on 17/10/2026.
+//
+
+#ifndef CONCEPTUAL_JOB_RUNNER_H
+#define CONCEPTUAL_JOB_RUNNER_H
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <deque>
+#include <string>
+#include <functional>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+namespace concpt::declare {
+    /**
+     * @class job_runner
+     * @brief Runs external commands as concurrent child processes, with per-job logs and retries.
+     *
+     * @details Up to `max_processes` jobs run at once, started with posix_spawnp, so commands are resolved through PATH
+     * and no shell is involved. The standard output and error of every attempt are appended to the log of its job,
+     * after a header line naming the attempt and the command. Failed jobs are queued again until they have been tried
+     * `max_attempts` times.
+     */
+    class job_runner {
+    public:
+        struct job {
+            /** @brief Name used in progress reports and results */
+            std::string name;
+
+            /** @brief Program followed by its arguments */
+            std::vector<std::string> command;
+
+            std::filesystem::path log_path;
+        };
+
+        struct result {
+            std::string name;
+
+            /** @brief Exit code of the last attempt, 128 + signal number if it was killed, 127 if it could not be started */
+            int exit_code = 0;
+            std::size_t attempts = 0;
+
+            [[nodiscard]] bool succeeded () const noexcept {
+                return this->exit_code == 0;
+            }
+        };
+
+        struct progress {
+            std::size_t total = 0;
+            std::size_t succeeded = 0;
+            std::size_t failed = 0;
+            std::size_t running = 0;
+
+            /** @brief Attempts that failed and were queued again */
+            std::size_t retried = 0;
+        };
+
+        using progress_callback = std::function<void(const progress&)>;
+
+        /**
+         * @throw std::invalid_argument Thrown if @p IN_MAX_PROCESSES or @p IN_MAX_ATTEMPTS is zero.
+         */
+        explicit job_runner (const std::size_t IN_MAX_PROCESSES = std::max<std::size_t>(std::thread::hardware_concurrency(), 1),
+                             const std::size_t IN_MAX_ATTEMPTS = 2) : max_processes(IN_MAX_PROCESSES), max_attempts(IN_MAX_ATTEMPTS) {
+            if (IN_MAX_PROCESSES == 0 || IN_MAX_ATTEMPTS == 0) {
+                throw std::invalid_argument("Job runner needs at least one process and one attempt");
+            }
+        }
+
+        virtual ~job_runner () = default;
+
+        /**
+         * @brief Called after every finished attempt, from the thread calling `run`.
+         */
+        void set_progress_callback (progress_callback IN_CALLBACK) {
+            this->callback = std::move(IN_CALLBACK);
+        }
+
+        /**
+         * @brief Runs every job of @p IN_JOBS to success or until it has no attempts left.
+         *
+         * @return Result of every job, in the order of @p IN_JOBS.
+         *
+         * @throw std::invalid_argument Thrown if a job has an empty command.
+         */
+        std::vector<result> run (const std::vector<job> &IN_JOBS) {
+            for (const job &each : IN_JOBS) {
+                if (each.command.empty()) throw std::invalid_argument("Job has no command: " + each.name);
+            }
+
+            std::vector<result> OUT_RESULTS(IN_JOBS.size());
+            for (std::size_t i = 0; i < IN_JOBS.size(); i++) OUT_RESULTS[i].name = IN_JOBS[i].name;
+
+            std::deque<std::size_t> pending;
+            for (std::size_t i = 0; i < IN_JOBS.size(); i++) pending.push_back(i);
+            std::vector<std::pair<pid_t, std::size_t>> running;
+            progress status{IN_JOBS.size()};
+
+            while (!pending.empty() || !running.empty()) {
+                while (!pending.empty() && running.size() < this->max_processes) {
+                    const std::size_t next = pending.front();
+                    pending.pop_front();
+                    OUT_RESULTS[next].attempts++;
+                    const pid_t child = spawn(IN_JOBS[next], OUT_RESULTS[next].attempts);
+                    if (child > 0) {
+                        running.emplace_back(child, next);
+                    } else {
+                        this->finish(IN_JOBS[next], OUT_RESULTS[next], 127, pending, next, status);
+                    }
+                }
+                status.running = running.size();
+
+                bool reaped = false;
+                for (auto it = running.begin(); it != running.end();) {
+                    int wait_status = 0;
+                    const pid_t done = ::waitpid(it->first, &wait_status, WNOHANG);
+                    if (done == 0 || (done < 0 && errno == EINTR)) {
+                        ++it;
+                        continue;
+                    }
+                    int exit_code = 127;
+                    if (done > 0 && WIFEXITED(wait_status)) exit_code = WEXITSTATUS(wait_status);
+                    else if (done > 0 && WIFSIGNALED(wait_status)) exit_code = 128 + WTERMSIG(wait_status);
+                    const std::size_t index = it->second;
+                    it = running.erase(it);
+                    status.running = running.size();
+                    this->finish(IN_JOBS[index], OUT_RESULTS[index], exit_code, pending, index, status);
+                    reaped = true;
+                }
+                if (!reaped && !running.empty()) std::this_thread::sleep_for(poll_interval);
+            }
+            return OUT_RESULTS;
+        }
+
+        [[nodiscard]] std::size_t get_max_processes () const noexcept {
+            return this->max_processes;
+        }
+
+        [[nodiscard]] std::size_t get_max_attempts () const noexcept {
+            return this->max_attempts;
+        }
+
+    private:
+        static constexpr std::chrono::milliseconds poll_interval{20};
+
+        std::size_t max_processes;
+        std::size_t max_attempts;
+        progress_callback callback;
+
+        /**
+         * @brief Records a finished attempt and queues the job again if it failed and has attempts left.
+         */
+        void finish (const job &IN_JOB, result &OUT_RESULT, const int IN_EXIT_CODE, std::deque<std::size_t> &OUT_PENDING,
+                     const std::size_t IN_INDEX, progress &OUT_STATUS) const {
+            OUT_RESULT.exit_code = IN_EXIT_CODE;
+            if (IN_EXIT_CODE != 0) {
+                std::ofstream log(IN_JOB.log_path, std::ios::app);
+                log << "=== attempt " << OUT_RESULT.attempts << " failed with exit code " << IN_EXIT_CODE << " ===" << std::endl;
+            }
+            if (IN_EXIT_CODE == 0) {
+                OUT_STATUS.succeeded++;
+            } else if (OUT_RESULT.attempts < this->max_attempts) {
+                OUT_STATUS.retried++;
+                OUT_PENDING.push_back(IN_INDEX);
+            } else {
+                OUT_STATUS.failed++;
+            }
+            if (this->callback) this->callback(OUT_STATUS);
+        }
+
+        /**
+         * @brief Starts one attempt of @p IN_JOB with its output appended to the job log.
+         *
+         * @return Process id of the child, or -1 if it could not be started. The reason is written to the log.
+         */
+        static pid_t spawn (const job &IN_JOB, const std::size_t IN_ATTEMPT) {
+            {
+                std::ofstream log(IN_JOB.log_path, std::ios::app);
+                log << "=== attempt " << IN_ATTEMPT << ":";
+                for (const std::string &argument : IN_JOB.command) log << " " << argument;
+                log << " ===" << std::endl;
+            }
+
+            std::vector<char*> arguments;
+            arguments.reserve(IN_JOB.command.size() + 1);
+            for (const std::string &argument : IN_JOB.command) arguments.push_back(const_cast<char*>(argument.c_str()));
+            arguments.push_back(nullptr);
+
+            posix_spawn_file_actions_t actions;
+            ::posix_spawn_file_actions_init(&actions);
+            ::posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+            ::posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, IN_JOB.log_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+            ::posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+            pid_t OUT_CHILD = -1;
+            const int error = ::posix_spawnp(&OUT_CHILD, arguments.front(), &actions, nullptr, arguments.data(), environ);
+            ::posix_spawn_file_actions_destroy(&actions);
+            if (error != 0) {
+                std::ofstream log(IN_JOB.log_path, std::ios::app);
+                log << "Could not start " << IN_JOB.command.front() << ": " << std::strerror(error) << std::endl;
+                return -1;
+            }
+            return OUT_CHILD;
+        }
+    };
+}
+
+#endif //CONCEPTUAL_JOB_RUNNER_H
@@ -0,0 +1,159 @@
+//
+// Created by Harshavardhan Karnati on 17/10/2026.
+//
+
+#ifndef CONCEPTUAL_THREAD_POOL_H
+#define CONCEPTUAL_THREAD_POOL_H
+
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+#include <type_traits>
+#include <exception>
+
+namespace concpt::declare {
+    /**
+     * @class thread_pool
+     * @brief Fixed set of worker threads executing submitted tasks in FIFO order.
+     *
+     * @details Threads that wait on work submitted to the pool (`parallel_for`, `wait`) execute queued tasks while
+     * waiting. Nested use, e.g. a task that itself calls `parallel_for`, therefore can not dead-lock the pool.
+     */
+    class thread_pool {
+    public:
+        explicit thread_pool (const std::size_t IN_THREADS = std::max<std::size_t>(std::thread::hardware_concurrency(), 1)) {
+            this->workers.reserve(IN_THREADS);
+            for (std::size_t i = 0; i < IN_THREADS; i++) {
+                this->workers.emplace_back([this] {
+                    while (true) {
+                        std::function<void()> task;
+                        {
+                            std::unique_lock<std::mutex> lock(this->mutex);
+                            this->condition.wait(lock, [this] {return this->stopping || !this->tasks.empty();});
+                            if (this->stopping && this->tasks.empty()) return;
+                            task = std::move(this->tasks.front());
+                            this->tasks.pop();
+                        }
+                        task();
+                    }
+                });
+            }
+        }
+
+        thread_pool (const thread_pool&) = delete;
+        thread_pool& operator= (const thread_pool&) = delete;
+
+        virtual ~thread_pool () {
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->stopping = true;
+            }
+            this->condition.notify_all();
+            for (auto &worker : this->workers) worker.join();
+        }
+
+        /**
+         * @brief Process-wide pool with one worker per hardware thread, created on first use.
+         */
+        static thread_pool& shared () {
+            static thread_pool pool;
+            return pool;
+        }
+
+        /**
+         * @brief Queues @p IN_TASK for execution.
+         * @return Future holding the result (or the exception) of the task.
+         */
+        template <class function_type>
+        auto submit (function_type &&IN_TASK) -> std::future<std::invoke_result_t<std::decay_t<function_type>>> {
+            using return_type = std::invoke_result_t<std::decay_t<function_type>>;
+            auto task = std::make_shared<std::packaged_task<return_type()>>(std::forward<function_type>(IN_TASK));
+            std::future<return_type> OUT_FUTURE = task->get_future();
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                this->tasks.emplace([task] {(*task)();});
+            }
+            this->condition.notify_one();
+            return OUT_FUTURE;
+        }
+
+        /**
+         * @brief Waits for @p IN_FUTURE, executing queued tasks in the meantime.
+         */
+        template <class type>
+        void wait (const std::future<type> &IN_FUTURE) {
+            while (IN_FUTURE.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                if (!this->run_pending_task()) IN_FUTURE.wait_for(std::chrono::microseconds(100));
+            }
+        }
+
+        /**
+         * @brief Splits [IN_BEGIN, IN_END) in @p IN_CHUNKS contiguous ranges and calls @p IN_FUNCTION(begin, end) on each
+         * of them in parallel. The calling thread processes one of the ranges itself.
+         *
+         * @throw Rethrows the first exception thrown by @p IN_FUNCTION, after all ranges are done.
+         */
+        template <class function_type>
+        void parallel_for (const std::size_t IN_BEGIN, const std::size_t IN_END, std::size_t IN_CHUNKS, const function_type &IN_FUNCTION) {
+            if (IN_END <= IN_BEGIN) return;
+            IN_CHUNKS = std::clamp<std::size_t>(IN_CHUNKS, 1, IN_END - IN_BEGIN);
+            const std::size_t chunk_size = (IN_END - IN_BEGIN + IN_CHUNKS - 1) / IN_CHUNKS;
+
+            std::vector<std::future<void>> futures;
+            futures.reserve(IN_CHUNKS);
+            for (std::size_t start = IN_BEGIN + chunk_size; start < IN_END; start += chunk_size) {
+                const std::size_t end = std::min(start + chunk_size, IN_END);
+                futures.push_back(this->submit([&IN_FUNCTION, start, end] {IN_FUNCTION(start, end);}));
+            }
+
+            std::exception_ptr error = nullptr;
+            try {
+                IN_FUNCTION(IN_BEGIN, std::min(IN_BEGIN + chunk_size, IN_END));
+            } catch (...) {
+                error = std::current_exception();
+            }
+            for (auto &future : futures) {
+                this->wait(future);
+                try {
+                    future.get();
+                } catch (...) {
+                    if (!error) error = std::current_exception();
+                }
+            }
+            if (error) std::rethrow_exception(error);
+        }
+
+        [[nodiscard]] std::size_t size () const noexcept {
+            return this->workers.size();
+        }
+
+    private:
+        std::vector<std::thread> workers;
+        std::queue<std::function<void()>> tasks;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping = false;
+
+        bool run_pending_task () {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+                if (this->tasks.empty()) return false;
+                task = std::move(this->tasks.front());
+                this->tasks.pop();
+            }
+            task();
+            return true;
+        }
+    };
+}
+
+#endif //CONCEPTUAL_THREAD_POOL_H
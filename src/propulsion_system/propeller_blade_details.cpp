@@ -24,23 +24,27 @@ std::array<std::vector<std::pair<float, float>> *, 2>
 concpt::detail::blade_details::get_airfoil_coordinates (const float &IN_BLADE_LOCATION) {
     const concpt::detail::section_details& current_section = this->section_details[this->find_blade_index(IN_BLADE_LOCATION)];
 
-    std::vector<std::pair<float, float>> upper = this->airfoil_polar->hash_airfoil(current_section.airfoil_name).airfoil_coordinates_upper;
-    std::vector<std::pair<float, float>> lower = this->airfoil_polar->hash_airfoil(current_section.airfoil_name).airfoil_coordinates_lower;
+    airfoil_surrogate_model &model = this->airfoil_polar->hash_airfoil(current_section.airfoil_id);
 
-    if (upper.empty() || lower.empty())
+    if (model.airfoil_coordinates_upper.empty() || model.airfoil_coordinates_lower.empty())
             throw std::runtime_error("Airfoil coordinates are not available...");
 
-    return {&(this->airfoil_polar->hash_airfoil(current_section.airfoil_name).airfoil_coordinates_upper),
-            &(this->airfoil_polar->hash_airfoil(current_section.airfoil_name).airfoil_coordinates_lower)};
+    return {&model.airfoil_coordinates_upper, &model.airfoil_coordinates_lower};
 }
 float concpt::detail::blade_details::get_max_thickness_ratio (const float &IN_BLADE_LOCATION) {
     const concpt::detail::section_details& current_section = this->section_details[this->find_blade_index(IN_BLADE_LOCATION)];
-    const float max_thickeness = this->airfoil_polar->hash_airfoil(current_section.airfoil_name).max_thickness_ratio;
+    const float max_thickeness = this->airfoil_polar->hash_airfoil(current_section.airfoil_id).max_thickness_ratio;
     if (max_thickeness == 0.0f)
         throw std::runtime_error("No thickness data exists for this airfoil");
     else
         return max_thickeness;
 }
+void concpt::detail::blade_details::set_airfoil_polar (std::shared_ptr<concpt::airfoil_polar> IN_AIRFOIL_POLAR) {
+    for (concpt::detail::section_details &each_section : this->section_details) {
+        each_section.airfoil_id = IN_AIRFOIL_POLAR->get_airfoil_id(each_section.airfoil_name);
+    }
+    this->airfoil_polar = std::move(IN_AIRFOIL_POLAR);
+}
 
 
 concpt::detail::aero_results_get::aero_results_get (const concpt::detail::blade_details &IN_BLADE,
@@ -64,19 +68,15 @@ concpt::detail::aero_results_get& concpt::detail::aero_results_get::set_multipli
 }
 std::pair<float, float> concpt::detail::aero_results_get::get () {
     const concpt::detail::section_details &current_section = this->blade.section_details[this->blade.find_blade_index(this->location)];
-    if (this->perform_checks(current_section))
+    if (this->perform_checks(current_section.airfoil_id))
         throw std::out_of_range("Reynolds Number out-of-range...");
-    return this->blade.airfoil_polar->get_aero_values(current_section.airfoil_name, alpha, renolds_number, mach_number, multiplier);
+    return this->blade.airfoil_polar->get_aero_values(current_section.airfoil_id, alpha, renolds_number, mach_number, multiplier);
 }
-bool concpt::detail::aero_results_get::perform_checks (const concpt::detail::section_details &IN_CURRENT_SECTION) {
-    const float min_re = this->blade.airfoil_polar->hash_airfoil(IN_CURRENT_SECTION.airfoil_name).min_Re;
-    const float max_re = this->blade.airfoil_polar->hash_airfoil(IN_CURRENT_SECTION.airfoil_name).max_Re;
-
-    const float min_alpha = this->blade.airfoil_polar->hash_airfoil(IN_CURRENT_SECTION.airfoil_name).min_alpha;
-    const float max_alpha = this->blade.airfoil_polar->hash_airfoil(IN_CURRENT_SECTION.airfoil_name).max_alpha;
+bool concpt::detail::aero_results_get::perform_checks (const concpt::airfoil_id &IN_AIRFOIL) {
+    const airfoil_surrogate_model &model = this->blade.airfoil_polar->hash_airfoil(IN_AIRFOIL);
 
-    if ((this->renolds_number < min_re || this->renolds_number > max_re) ||
-        (this->alpha < min_alpha || this->alpha > max_alpha))
+    if ((this->renolds_number < model.min_Re || this->renolds_number > model.max_Re) ||
+        (this->alpha < model.min_alpha || this->alpha > model.max_alpha))
         return true;
     return false;
 }